@@ -3,14 +3,14 @@ set -e
 
 mkdir -p native/linux/"$1"/debug
 cd native/linux/"$1"/debug
-cmake ../../../.. -DCMAKE_BUILD_TYPE=Debug -DXT_ARCH="$1" -DXT_ENABLE_ASIO=0 -DXT_ENABLE_WASAPI=0 -DXT_ENABLE_DSOUND=0 -DXT_ENABLE_PULSE="$2" -DXT_ENABLE_ALSA="$3" -DXT_ENABLE_JACK="$4" >/dev/null
+cmake ../../../.. -DCMAKE_BUILD_TYPE=Debug -DXT_ARCH="$1" -DXT_ENABLE_ASIO=0 -DXT_ENABLE_WASAPI=0 -DXT_ENABLE_DSOUND=0 -DXT_ENABLE_PULSE="$2" -DXT_ENABLE_ALSA="$3" -DXT_ENABLE_JACK="$4" -DXT_ENABLE_FILE=1 >/dev/null
 make >/dev/null
 cd ../../../..
 cp ../dist/core/xt/"$1"/Debug/libxt-audio.so ../dist/cpp/sample/"$1"/Debug/libxt-audio.so || :
 
 mkdir -p native/linux/"$1"/release
 cd native/linux/"$1"/release
-cmake ../../../.. -DCMAKE_BUILD_TYPE=Release -DXT_ARCH="$1" -DXT_ENABLE_ASIO=0 -DXT_ENABLE_WASAPI=0 -DXT_ENABLE_DSOUND=0 -DXT_ENABLE_PULSE="$2" -DXT_ENABLE_ALSA="$3" -DXT_ENABLE_JACK="$4" >/dev/null
+cmake ../../../.. -DCMAKE_BUILD_TYPE=Release -DXT_ARCH="$1" -DXT_ENABLE_ASIO=0 -DXT_ENABLE_WASAPI=0 -DXT_ENABLE_DSOUND=0 -DXT_ENABLE_PULSE="$2" -DXT_ENABLE_ALSA="$3" -DXT_ENABLE_JACK="$4" -DXT_ENABLE_FILE=1 >/dev/null
 make >/dev/null
 cd ../../../..
 cp ../dist/core/xt/"$1"/Release/libxt-audio.so ../dist/cpp/sample/"$1"/Release/libxt-audio.so || :
\ No newline at end of file
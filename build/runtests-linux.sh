@@ -3,6 +3,12 @@ read -p "C++ x86 sample..."
 ../dist/cpp/sample/x86/Release/xt-sample
 read -p "C++ x64 sample..."
 ../dist/cpp/sample/x64/Release/xt-sample
+read -p "C++ x64 real-time check..."
+../dist/cpp/sample/x64/Release/xt-sample 8 || exit 1
+read -p "C++ x64 graph sample..."
+../dist/cpp/sample/x64/Release/xt-sample 10 || exit 1
+read -p "C++ x64 async sample..."
+../dist/cpp/sample/x64/Release/xt-sample-async || exit 1
 read -p "Java sample..."
 java -jar ../dist/java/sample/target/xt.sample-1.9.jar
 read -p ".NET Framework sample..."
@@ -1,9 +1,19 @@
+#include <xt/shared/Trace.hpp>
+#include <xt/private/Service.hpp>
+#include <xt/private/Platform.hpp>
 #include <xt/aggregate/Runner.hpp>
 
 XtAggregateRunner::
 XtAggregateRunner(XtAggregateStream* stream):
 _stream(stream), XtBlockingRunner(stream) { }
 
+// Sub-streams run at their own buffer sizes and are bridged by the ring
+// buffers, which are sized once when the aggregate is opened. Rejected
+// up front, so a running aggregate is left as it is.
+XtFault
+XtAggregateRunner::SetBufferSize(double bufferSize)
+{ return XtPlatform::instance->GetService(GetSystem())->GetUnsupportedFault(); }
+
 XtFault
 XtAggregateRunner::OnBuffer(int32_t index, XtBuffer const* buffer)
 {
@@ -24,6 +34,7 @@ XtAggregateRunner::OnBuffer(int32_t index, XtBuffer const* buffer)
 XtFault
 XtAggregateRunner::OnSlaveBuffer(int32_t index, XtBuffer const* buffer)
 {
+  XT_TRACE_SPAN("AggregateSlaveBuffer");
   XtBool interleaved = _params.stream.interleaved;
   XtChannels const* channels = &_stream->_channels[index];
   auto sampleSize = XtiGetSampleSize(_params.format.mix.sample);
@@ -50,6 +61,7 @@ XtAggregateRunner::OnSlaveBuffer(int32_t index, XtBuffer const* buffer)
 XtFault
 XtAggregateRunner::OnMasterBuffer(int32_t index, XtBuffer const* buffer)
 {
+  XT_TRACE_SPAN("AggregateMasterBuffer");
   XtFault fault;
   XtBool interleaved = _params.stream.interleaved;
   XtChannels const* channels = &_stream->_channels[index];
@@ -95,7 +107,7 @@ XtAggregateRunner::OnMasterBuffer(int32_t index, XtBuffer const* buffer)
   XtBuffer appBuffer = *buffer;
   appBuffer.input = appInput;
   appBuffer.output = appOutput;
-  if((fault = _params.stream.onBuffer(this, &appBuffer, _user)) != 0) return fault;
+  if((fault = OnAppBuffer(&appBuffer)) != 0) return fault;
 
   totalChannels = 0;
   for(size_t i = 0; i < _stream->_streams.size(); i++)
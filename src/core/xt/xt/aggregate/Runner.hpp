@@ -13,6 +13,7 @@ public XtBlockingRunner
 
   XtFault OnSlaveBuffer(int32_t index, XtBuffer const* buffer);
   XtFault OnMasterBuffer(int32_t index, XtBuffer const* buffer);
+  XtFault SetBufferSize(double bufferSize) override final;
   XtFault OnBuffer(int32_t index, XtBuffer const* buffer) override final;
 };
 
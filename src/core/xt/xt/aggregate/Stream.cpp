@@ -23,6 +23,25 @@ XtAggregateStream::StartMasterBuffer()
 XtFault
 XtAggregateStream::BlockMasterBuffer(XtBool* ready)
 { return _streams[_masterIndex]->BlockMasterBuffer(ready); }
+void
+XtAggregateStream::WakeMasterBuffer()
+{ _streams[_masterIndex]->WakeMasterBuffer(); }
+
+XtFault
+XtAggregateStream::SetFreewheel(XtBool freewheel)
+{
+  XtFault fault;
+  for(size_t i = 0; i < _streams.size(); i++)
+    if((fault = _streams[i]->SetFreewheel(freewheel)) != 0) return fault;
+  return 0;
+}
+
+void
+XtAggregateStream::Rewind()
+{
+  for(size_t i = 0; i < _streams.size(); i++)
+    _streams[i]->Rewind();
+}
 
 void
 XtAggregateStream::StopSlaveBuffer()
@@ -33,6 +52,25 @@ XtAggregateStream::StopSlaveBuffer()
       _streams[i]->StopSlaveBuffer();
 }
 
+// Same ordering as stop/start. Rings are cleared on resume since the
+// underlying streams do not continue in lockstep.
+XtFault
+XtAggregateStream::PauseSlaveBuffer(XtBool pause)
+{
+  XtFault fault;
+  if(pause && (fault = _streams[_masterIndex]->PauseSlaveBuffer(XtTrue)) != 0) return fault;
+  for(size_t i = 0; i < _streams.size(); i++)
+    if(i != static_cast<size_t>(_masterIndex))
+      if((fault = _streams[i]->PauseSlaveBuffer(pause)) != 0) return fault;
+  if(pause) return 0;
+  for(size_t i = 0; i < _streams.size(); i++)
+  {
+    _rings[i].input.Clear();
+    _rings[i].output.Clear();
+  }
+  return _streams[_masterIndex]->PauseSlaveBuffer(XtFalse);
+}
+
 XtFault
 XtAggregateStream::PrefillOutputBuffer()
 {
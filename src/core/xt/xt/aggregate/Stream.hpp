@@ -20,7 +20,11 @@ public XtBlockingStream
   std::vector<std::unique_ptr<XtBlockingStream>> _streams;
 
   XtAggregateStream() = default;
+  void Rewind() override final;
+  void WakeMasterBuffer() override final;
   XtSystem GetSystem() const override;
+  XtFault SetFreewheel(XtBool freewheel) override final;
+  XtFault PauseSlaveBuffer(XtBool pause) override final;
 
   XT_IMPLEMENT_STREAM_BASE();
   XT_IMPLEMENT_BLOCKING_STREAM();
@@ -18,5 +18,9 @@ typedef uint32_t (XT_CALLBACK
 *XtOnBuffer)(XtStream const* stream, XtBuffer const* buffer, void* user);
 typedef void (XT_CALLBACK
 *XtOnRunning)(XtStream const* stream, XtBool running, XtError error, void* user);
+typedef void (XT_CALLBACK
+*XtOnReconfigure)(XtStream const* stream, int32_t frames, int32_t rate, void* user);
+typedef void (XT_CALLBACK
+*XtOnBudgetExceeded)(XtStream const* stream, double duration, double budget, void* user);
 
 #endif // XT_API_CALLBACKS_H
\ No newline at end of file
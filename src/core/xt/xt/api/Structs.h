@@ -15,6 +15,8 @@ typedef struct XtFormat XtFormat;
 typedef struct XtBuffer XtBuffer; 
 typedef struct XtVersion XtVersion; 
 typedef struct XtLatency XtLatency; 
+typedef struct XtRingStats XtRingStats;
+typedef struct XtRecordingStats XtRecordingStats;
 typedef struct XtChannels XtChannels; 
 typedef struct XtErrorInfo XtErrorInfo; 
 typedef struct XtBufferSize XtBufferSize;
@@ -54,6 +56,21 @@ struct XtLatency
   double output;
 };
 
+struct XtRingStats
+{
+  int32_t readable;
+  int32_t writable;
+  uint64_t overflows;
+  uint64_t underflows;
+};
+
+struct XtRecordingStats
+{
+  uint64_t written;
+  uint64_t lag;
+  uint64_t dropped;
+};
+
 struct XtChannels 
 {
   int32_t inputs;
@@ -102,6 +119,7 @@ struct XtStreamParams
   XtOnBuffer onBuffer;
   XtOnXRun onXRun;
   XtOnRunning onRunning;
+  XtOnReconfigure onReconfigure;
 };
 
 struct XtDeviceStreamParams 
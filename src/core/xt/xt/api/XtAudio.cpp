@@ -1,4 +1,6 @@
 #include <xt/api/XtAudio.h>
+#include <xt/shared/Trace.hpp>
+#include <xt/shared/RtCheck.hpp>
 #include <xt/shared/Services.hpp>
 #include <xt/private/Platform.hpp>
 
@@ -19,6 +21,17 @@ void XT_CALL
 XtAudioSetAssertTerminates(XtBool terminates)
 { XtiSetAssertTerminates(terminates); }
 
+uint64_t XT_CALL
+XtAudioGetRtViolations(void)
+{ return XtiGetRtViolations(); }
+
+XtBool XT_CALL
+XtAudioWriteTrace(char const* path)
+{
+  XT_ASSERT_API(path != nullptr);
+  return XtiWriteTrace(path);
+}
+
 XtErrorInfo XT_CALL
 XtAudioGetErrorInfo(XtError error) 
 {
@@ -73,5 +86,7 @@ XtAudioInit(char const* id, void* window)
   if(dsound) result->_services.emplace_back(std::move(dsound));
   auto wasapi = XtiCreateWasapiService();
   if(wasapi) result->_services.emplace_back(std::move(wasapi));
+  auto file = XtiCreateFileService();
+  if(file) result->_services.emplace_back(std::move(file));
   return XtPlatform::instance = result.release();
 }
\ No newline at end of file
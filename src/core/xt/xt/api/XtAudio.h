@@ -27,6 +27,10 @@ XT_API XtAttributes XT_CALL
 XtAudioGetSampleAttributes(XtSample sample);
 XT_API void XT_CALL
 XtAudioSetAssertTerminates(XtBool terminates);
+XT_API XtBool XT_CALL
+XtAudioWriteTrace(char const* path);
+XT_API uint64_t XT_CALL
+XtAudioGetRtViolations(void);
 
 #ifdef __cplusplus
 }
@@ -94,7 +94,6 @@ XtDeviceOpenStream(XtDevice* d, XtDeviceStreamParams const* params, void* user,
   XT_ASSERT_API(stream != nullptr);
   XT_ASSERT_API(XtiCalledOnMainThread());
   XT_ASSERT_API(params->bufferSize > 0.0);
-  XT_ASSERT_API(params->stream.onBuffer != nullptr);
   if((fault = XtiSupportsFormat(d, &params->format)) != 0) return XtiCreateError(d->GetSystem(), fault);
   return d->OpenStream(params, user, stream);
 }
@@ -24,7 +24,7 @@ XtPrintCause(XtCause cause)
 char const* XT_CALL 
 XtPrintSystem(XtSystem system) 
 {
-  XT_ASSERT_API(XtSystemALSA <= system && system <= XtSystemDSound);
+  XT_ASSERT_API(XtSystemALSA <= system && system <= XtSystemFile);
   switch(system) 
   {
   case XtSystemALSA: return "ALSA";
@@ -33,6 +33,7 @@ XtPrintSystem(XtSystem system)
   case XtSystemWASAPI: return "WASAPI";
   case XtSystemPulse: return "PulseAudio";
   case XtSystemDSound: return "DirectSound";
+  case XtSystemFile: return "File";
   default: XT_ASSERT(false); return nullptr;
   }
 }
@@ -105,6 +106,9 @@ XtPrintServiceCaps(XtServiceCaps capabilities)
   if((capabilities & XtServiceCapsAggregation) != 0) result += "Aggregation, ";
   if((capabilities & XtServiceCapsControlPanel) != 0) result += "ControlPanel, ";
   if((capabilities & XtServiceCapsXRunDetection) != 0) result += "XRunDetection, ";
+  if((capabilities & XtServiceCapsFreewheel) != 0) result += "Freewheel, ";
+  if((capabilities & XtServiceCapsBufferSize) != 0) result += "BufferSize, ";
+  if((capabilities & XtServiceCapsPause) != 0) result += "Pause, ";
   std::memcpy(buffer, result.data(), result.size() - 2);
   buffer[result.size() - 2] = '\0';
   return buffer;
@@ -51,7 +51,6 @@ XtServiceAggregateStream(XtService const* s, XtAggregateStreamParams const* para
   XT_ASSERT_API(XtiCalledOnMainThread());
   XT_ASSERT_API(params->master != nullptr);
   XT_ASSERT_API(params->devices != nullptr);
-  XT_ASSERT_API(params->stream.onBuffer != nullptr);
   XT_ASSERT_API((s->GetCapabilities() & XtServiceCapsAggregation) != 0);
   return XtiCreateError(s->GetSystem(), s->AggregateStream(params, user, stream));
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <xt/api/XtStream.h>
 #include <xt/shared/Shared.hpp>
 #include <xt/private/Stream.hpp>
+#include <xt/private/Platform.hpp>
 
 #include <cstring>
 
@@ -29,6 +30,7 @@ void XT_CALL
 XtStreamDestroy(XtStream* s) 
 { 
   XT_ASSERT_VOID_API(XtiCalledOnMainThread());
+  if(s != nullptr) s->_watchdog.Stop();
   delete s;
 }
 
@@ -40,11 +42,47 @@ XtStreamStop(XtStream* s)
   s->Stop();
 }
 
+void XT_CALL 
+XtStreamRewind(XtStream* s) 
+{
+  XT_ASSERT_VOID_API(s != nullptr);
+  s->Rewind();
+}
+
+XtError XT_CALL 
+XtStreamSetFreewheel(XtStream* s, XtBool freewheel) 
+{
+  XT_ASSERT_API(s != nullptr);
+  XT_ASSERT_API(XtiCalledOnMainThread());
+  XT_ASSERT_API((XtPlatform::instance->GetService(s->GetSystem())->GetCapabilities() & XtServiceCapsFreewheel) != 0);
+  return XtiCreateError(s->GetSystem(), s->SetFreewheel(freewheel));
+}
+
+XtError XT_CALL 
+XtStreamSetPaused(XtStream* s, XtBool paused) 
+{
+  XT_ASSERT_API(s != nullptr);
+  XT_ASSERT_API(XtiCalledOnMainThread());
+  XT_ASSERT_API((XtPlatform::instance->GetService(s->GetSystem())->GetCapabilities() & XtServiceCapsPause) != 0);
+  return XtiCreateError(s->GetSystem(), s->SetPaused(paused));
+}
+
+XtError XT_CALL 
+XtStreamSetBufferSize(XtStream* s, double bufferSize) 
+{
+  XT_ASSERT_API(s != nullptr);
+  XT_ASSERT_API(bufferSize > 0.0);
+  XT_ASSERT_API(XtiCalledOnMainThread());
+  XT_ASSERT_API((XtPlatform::instance->GetService(s->GetSystem())->GetCapabilities() & XtServiceCapsBufferSize) != 0);
+  return XtiCreateError(s->GetSystem(), s->SetBufferSize(bufferSize));
+}
+
 XtError XT_CALL 
 XtStreamStart(XtStream* s) 
 {
   XT_ASSERT_API(s != nullptr);
   XT_ASSERT_API(XtiCalledOnMainThread());
+  XT_ASSERT_API(s->_params.stream.onBuffer != nullptr || s->_queue._active);
   return XtiCreateError(s->GetSystem(), s->Start());
 }
 
@@ -64,4 +102,100 @@ XtStreamGetLatency(XtStream const* s, XtLatency* latency)
   XT_ASSERT_API(latency != nullptr);
   memset(latency, 0, sizeof(XtLatency));
   return XtiCreateError(s->GetSystem(), s->GetLatency(latency));
+}
+
+void XT_CALL 
+XtStreamStopRecording(XtStream* s)
+{
+  XT_ASSERT_VOID_API(s != nullptr);
+  XT_ASSERT_VOID_API(XtiCalledOnMainThread());
+  s->_recorder.Stop();
+}
+
+XtError XT_CALL 
+XtStreamStartRecording(XtStream* s, char const* path, XtBool output)
+{
+  XT_ASSERT_API(s != nullptr);
+  XT_ASSERT_API(path != nullptr);
+  XT_ASSERT_API(XtiCalledOnMainThread());
+  XT_ASSERT_API(!s->_recorder.IsRecording());
+  XT_ASSERT_API(XtPlatform::instance->GetService(XtSystemFile) != nullptr);
+  auto const& channels = s->_params.format.channels;
+  XT_ASSERT_API((output? channels.outputs: channels.inputs) > 0);
+  auto fault = s->_recorder.Start(path, &s->_params.format, s->_params.stream.interleaved, output != XtFalse);
+  return XtiCreateError(XtSystemFile, fault);
+}
+
+void XT_CALL 
+XtStreamGetRecordingStats(XtStream const* s, XtRecordingStats* stats)
+{
+  XT_ASSERT_VOID_API(s != nullptr);
+  XT_ASSERT_VOID_API(stats != nullptr);
+  XT_ASSERT_VOID_API(XtiCalledOnMainThread());
+  s->_recorder.GetStats(stats);
+}
+
+void XT_CALL 
+XtStreamInitRings(XtStream* s, int32_t frames, int32_t prebuffer)
+{
+  XT_ASSERT_VOID_API(s != nullptr);
+  XT_ASSERT_VOID_API(frames > 0);
+  XT_ASSERT_VOID_API(0 <= prebuffer && prebuffer <= frames);
+  XT_ASSERT_VOID_API(XtiCalledOnMainThread());
+  XT_ASSERT_VOID_API(!s->IsRunning());
+  XT_ASSERT_VOID_API(s->_params.stream.onBuffer == nullptr);
+  s->_queue.Init(&s->_params.format, s->_params.stream.interleaved, frames, prebuffer);
+}
+
+int32_t XT_CALL 
+XtStreamRead(XtStream* s, void* data, int32_t frames, int32_t timeout)
+{
+  XT_ASSERT_API(s != nullptr);
+  XT_ASSERT_API(frames >= 0);
+  XT_ASSERT_API(data != nullptr);
+  XT_ASSERT_API(s->_queue._active);
+  XT_ASSERT_API(s->_params.format.channels.inputs > 0);
+  return s->_queue.Transfer(s->_queue._rings.input, data, frames, timeout, false);
+}
+
+int32_t XT_CALL 
+XtStreamWrite(XtStream* s, void const* data, int32_t frames, int32_t timeout)
+{
+  XT_ASSERT_API(s != nullptr);
+  XT_ASSERT_API(frames >= 0);
+  XT_ASSERT_API(data != nullptr);
+  XT_ASSERT_API(s->_queue._active);
+  XT_ASSERT_API(s->_params.format.channels.outputs > 0);
+  return s->_queue.Transfer(s->_queue._rings.output, const_cast<void*>(data), frames, timeout, true);
+}
+
+void XT_CALL 
+XtStreamGetRingStats(XtStream const* s, XtRingStats* stats)
+{
+  XT_ASSERT_VOID_API(s != nullptr);
+  XT_ASSERT_VOID_API(stats != nullptr);
+  memset(stats, 0, sizeof(XtRingStats));
+  s->_queue.GetStats(stats);
+}
+
+int32_t XT_CALL 
+XtStreamGetReadyFd(XtStream* s, int32_t frames)
+{
+  XT_ASSERT_API(s != nullptr);
+  XT_ASSERT_API(frames > 0);
+  XT_ASSERT_API(s->_queue._active);
+  XT_ASSERT_API(XtiCalledOnMainThread());
+  XT_ASSERT_API(!s->IsRunning());
+  return s->_queue.GetReadyFd(frames);
+}
+
+void XT_CALL 
+XtStreamSetBudget(XtStream* s, double fraction, XtOnBudgetExceeded onBudgetExceeded)
+{
+  XT_ASSERT_VOID_API(s != nullptr);
+  XT_ASSERT_VOID_API(XtiCalledOnMainThread());
+  XT_ASSERT_VOID_API(!s->IsRunning());
+  XT_ASSERT_VOID_API(onBudgetExceeded == nullptr || fraction > 0.0);
+  if(onBudgetExceeded == nullptr) s->_watchdog.Stop();
+  else s->_watchdog.Start(s, s->_user, fraction, onBudgetExceeded);
 }
\ No newline at end of file
@@ -16,6 +16,14 @@ XtStreamStop(XtStream* s);
 XT_API XtError XT_CALL 
 XtStreamStart(XtStream* s);
 XT_API void XT_CALL 
+XtStreamRewind(XtStream* s);
+XT_API XtError XT_CALL 
+XtStreamSetFreewheel(XtStream* s, XtBool freewheel);
+XT_API XtError XT_CALL 
+XtStreamSetPaused(XtStream* s, XtBool paused);
+XT_API XtError XT_CALL 
+XtStreamSetBufferSize(XtStream* s, double bufferSize);
+XT_API void XT_CALL 
 XtStreamDestroy(XtStream* s);
 XT_API void* XT_CALL
 XtStreamGetHandle(XtStream const* s);
@@ -27,6 +35,24 @@ XT_API XtError XT_CALL
 XtStreamGetFrames(XtStream const* s, int32_t* frames);
 XT_API XtError XT_CALL 
 XtStreamGetLatency(XtStream const* s, XtLatency* latency);
+XT_API void XT_CALL 
+XtStreamStopRecording(XtStream* s);
+XT_API XtError XT_CALL 
+XtStreamStartRecording(XtStream* s, char const* path, XtBool output);
+XT_API void XT_CALL 
+XtStreamGetRecordingStats(XtStream const* s, XtRecordingStats* stats);
+XT_API void XT_CALL 
+XtStreamInitRings(XtStream* s, int32_t frames, int32_t prebuffer);
+XT_API int32_t XT_CALL 
+XtStreamRead(XtStream* s, void* data, int32_t frames, int32_t timeout);
+XT_API int32_t XT_CALL 
+XtStreamWrite(XtStream* s, void const* data, int32_t frames, int32_t timeout);
+XT_API void XT_CALL 
+XtStreamGetRingStats(XtStream const* s, XtRingStats* stats);
+XT_API int32_t XT_CALL 
+XtStreamGetReadyFd(XtStream* s, int32_t frames);
+XT_API void XT_CALL 
+XtStreamSetBudget(XtStream* s, double fraction, XtOnBudgetExceeded onBudgetExceeded);
 
 #ifdef __cplusplus
 }
@@ -3,6 +3,7 @@
 #include <xt/backend/alsa/Shared.hpp>
 #include <xt/backend/alsa/Private.hpp>
 
+#include <sys/timerfd.h>
 #include <memory>
 #include <cstring>
 #include <sstream>
@@ -26,7 +27,8 @@ XtiAlsaTypeIsMMap(XtAlsaType type)
   case XtAlsaType::InputRw:
   case XtAlsaType::OutputRw: return false;
   case XtAlsaType::InputMMap: 
-  case XtAlsaType::OutputMMap: return true;
+  case XtAlsaType::OutputMMap: 
+  case XtAlsaType::OutputTimer: return true;
   default: XT_ASSERT(false); return false;
   }
 }
@@ -39,7 +41,8 @@ XtiAlsaTypeIsOutput(XtAlsaType type)
   case XtAlsaType::InputRw:
   case XtAlsaType::InputMMap: return false;
   case XtAlsaType::OutputRw: 
-  case XtAlsaType::OutputMMap: return true;
+  case XtAlsaType::OutputMMap: 
+  case XtAlsaType::OutputTimer: return true;
   default: XT_ASSERT(false); return false;
   }
 }
@@ -72,6 +75,7 @@ XtiGetAlsaNameSuffix(XtAlsaType type)
   case XtAlsaType::InputMMap: return "Input MMap";
   case XtAlsaType::OutputRw: return "Output R/W";
   case XtAlsaType::OutputMMap: return "Output MMap";
+  case XtAlsaType::OutputTimer: return "Output Timer";
   default: return XT_ASSERT(false), nullptr;
   }
 }
@@ -119,6 +123,15 @@ XtiAlsaOpenPcm(XtAlsaDeviceInfo const& info, XtAlsaPcm* pcm)
   return 0;
 }
 
+int
+XtiAlsaOpenTimer(XtAlsaTimer* timer)
+{
+  int fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+  if(fd == -1) return -errno;
+  timer->fd = fd;
+  return 0;
+}
+
 bool
 XtiParseAlsaDeviceInfo(std::string const& id, XtAlsaDeviceInfo* info)
 {
@@ -126,7 +139,7 @@ XtiParseAlsaDeviceInfo(std::string const& id, XtAlsaDeviceInfo* info)
   if(id.substr(id.length() - 7, 6) != ",TYPE=") return false;
   char typeCode = id[id.length() - 1];
   auto type = static_cast<XtAlsaType>(typeCode - '0');
-  if(!(XtAlsaType::InputRw <= type && type <= XtAlsaType::OutputMMap)) return false;
+  if(!(XtAlsaType::InputRw <= type && type <= XtAlsaType::OutputTimer)) return false;
   info->name = id;
   info->type = type;   
   info->name.erase(id.size() - 7, 7);
@@ -159,13 +172,21 @@ XtiGetAlsaAccess(XtAlsaType type, XtBool interleaved)
 
 int
 XtiAlsaOpenPcm(XtAlsaDeviceInfo const& info, XtFormat const* format, XtAlsaPcm* pcm)
+{
+  XT_VERIFY_ALSA(XtiAlsaOpenPcm(info, pcm));
+  return XtiAlsaInitHwParams(info.type, format, pcm);
+}
+
+// Restricts the full configuration space of an open pcm to the format.
+int
+XtiAlsaInitHwParams(XtAlsaType type, XtFormat const* format, XtAlsaPcm* pcm)
 {
   int err;
-  bool output = XtiAlsaTypeIsOutput(info.type);
+  bool output = XtiAlsaTypeIsOutput(type);
   auto sample = XtiToAlsaSample(format->mix.sample);
-  auto interleaved = XtiGetAlsaAccess(info.type, XtTrue);
-  auto nonInterleaved = XtiGetAlsaAccess(info.type, XtFalse);
-  XT_VERIFY_ALSA(XtiAlsaOpenPcm(info, pcm));
+  auto interleaved = XtiGetAlsaAccess(type, XtTrue);
+  auto nonInterleaved = XtiGetAlsaAccess(type, XtFalse);
+  XT_VERIFY_ALSA(snd_pcm_hw_params_any(pcm->pcm, pcm->params));
   int32_t channels = output? format->channels.outputs: format->channels.inputs;
   if((err = snd_pcm_hw_params_set_format(pcm->pcm, pcm->params, sample)) < 0) return err;
   if((err = snd_pcm_hw_params_set_channels(pcm->pcm, pcm->params, channels)) < 0) return err;
@@ -75,41 +75,13 @@ AlsaDevice::GetChannelName(XtBool output, int32_t index, char* buffer, int32_t*
 XtFault
 AlsaDevice::OpenBlockingStream(XtBlockingParams const* params, XtBlockingStream** stream)
 {
-  snd_pcm_uframes_t min;
-  snd_pcm_uframes_t max;
-  snd_pcm_uframes_t buffer;
-  snd_pcm_sw_params_t* swParams;
-
-  snd_pcm_sw_params_alloca(&swParams);
   auto result = std::make_unique<AlsaStream>();
-  XT_VERIFY_ALSA(XtiAlsaOpenPcm(_info, &params->format, &result->_pcm));
-
-  result->_alsaInterleaved = params->interleaved;
-  auto access = XtiGetAlsaAccess(_info.type, params->interleaved);
-  if(snd_pcm_hw_params_set_access(result->_pcm.pcm, result->_pcm.params, access) != 0)
-  {
-    result->_alsaInterleaved = !params->interleaved;
-    access = XtiGetAlsaAccess(_info.type, !params->interleaved);
-    XT_VERIFY_ALSA(snd_pcm_hw_params_set_access(result->_pcm.pcm, result->_pcm.params, access));
-  }
-
-  XT_VERIFY_ALSA(snd_pcm_hw_params_get_buffer_size_min(result->_pcm.params, &min));
-  XT_VERIFY_ALSA(snd_pcm_hw_params_get_buffer_size_max(result->_pcm.params, &max));
-  buffer = params->bufferSize / 1000.0 * params->format.mix.rate;
-  buffer = std::clamp(buffer, min, max);
-  XT_VERIFY_ALSA(snd_pcm_hw_params_set_buffer_size_near(result->_pcm.pcm, result->_pcm.params, &buffer));  
-  XT_VERIFY_ALSA(snd_pcm_hw_params(result->_pcm.pcm, result->_pcm.params));
-
-  XT_VERIFY_ALSA(snd_pcm_sw_params_current(result->_pcm.pcm, swParams));
-  XT_VERIFY_ALSA(snd_pcm_sw_params_set_start_threshold(result->_pcm.pcm, swParams, buffer));
-  XT_VERIFY_ALSA(snd_pcm_sw_params_set_tstamp_mode(result->_pcm.pcm, swParams, SND_PCM_TSTAMP_ENABLE));
-  XT_VERIFY_ALSA(snd_pcm_sw_params(result->_pcm.pcm, swParams));
-
   result->_processed = 0;
-  result->_frames = buffer;
   result->_type = _info.type;
-  auto channels = params->format.channels.inputs + params->format.channels.outputs;
-  XtiInitBuffers(result->_alsaBuffers, params->format.mix.sample, channels, buffer);
+  XT_VERIFY_ALSA(XtiAlsaOpenPcm(_info, &params->format, &result->_pcm));
+  XT_VERIFY_ALSA(result->Configure(&params->format, params->interleaved, params->bufferSize));
+  if(_info.type == XtAlsaType::OutputTimer)
+    XT_VERIFY_ALSA(XtiAlsaOpenTimer(&result->_timer));
   *stream = result.release();
   return 0;
 }
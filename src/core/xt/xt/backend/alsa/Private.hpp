@@ -4,6 +4,7 @@
 
 #include <alsa/asoundlib.h>
 #include <string>
+#include <unistd.h>
 
 #define XT_VERIFY_ALSA(c)     \
   do { int e = (c); if(e < 0) \
@@ -14,9 +15,15 @@ enum XtAlsaType
   InputRw,
   InputMMap,
   OutputRw,
-  OutputMMap
+  OutputMMap,
+  OutputTimer
 };
 
+inline double const
+XtiAlsaTimerGuardMs = 2.0;
+inline double const
+XtiAlsaTimerWatermarkMs = 20.0;
+
 struct XtAlsaDeviceInfo
 {
   XtAlsaType type;
@@ -34,6 +41,16 @@ struct XtAlsaPcm
   XtAlsaPcm& operator=(XtAlsaPcm const&) = delete;
 };
 
+struct XtAlsaTimer
+{
+  int fd;
+  XtAlsaTimer(XtAlsaTimer const&) = delete;
+  XtAlsaTimer& operator=(XtAlsaTimer const&) = delete;
+
+  XtAlsaTimer(): fd(-1) { }
+  ~XtAlsaTimer() { if(fd != -1) close(fd); }
+};
+
 snd_pcm_format_t
 XtiToAlsaSample(XtSample sample);
 bool
@@ -50,10 +67,14 @@ snd_pcm_access_t
 XtiGetAlsaAccess(XtAlsaType type, XtBool interleaved);
 int
 XtiAlsaOpenPcm(XtAlsaDeviceInfo const& info, XtAlsaPcm* pcm);
+int
+XtiAlsaOpenTimer(XtAlsaTimer* timer);
 bool
 XtiParseAlsaDeviceInfo(std::string const& id, XtAlsaDeviceInfo* info);
 int
 XtiAlsaOpenPcm(XtAlsaDeviceInfo const& info, XtFormat const* format, XtAlsaPcm* pcm);
+int
+XtiAlsaInitHwParams(XtAlsaType type, XtFormat const* format, XtAlsaPcm* pcm);
 void
 XtiLogAlsaError(char const* file, int line, char const* fun, int err, char const* fmt, ...);
 
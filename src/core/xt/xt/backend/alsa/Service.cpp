@@ -8,6 +8,9 @@
 XtFault
 AlsaService::GetFormatFault() const
 { return -EINVAL; }
+XtFault
+AlsaService::GetUnsupportedFault() const
+{ return -ENOTSUP; }
 AlsaService::
 AlsaService()
 { XT_ASSERT(snd_lib_error_set_handler(&XtiLogAlsaError) == 0); }
@@ -25,6 +28,8 @@ AlsaService::GetCapabilities() const
   auto result = XtServiceCapsTime
   | XtServiceCapsLatency
   | XtServiceCapsAggregation
+  | XtServiceCapsBufferSize
+  | XtServiceCapsPause
   | XtServiceCapsXRunDetection;
   return static_cast<XtServiceCaps>(result);
 }
@@ -64,6 +69,8 @@ AlsaService::OpenDeviceList(XtEnumFlags flags, XtDeviceList** list) const
       result->_devices.push_back(info);
       info.type = XtAlsaType::OutputMMap;
       result->_devices.push_back(info);
+      info.type = XtAlsaType::OutputTimer;
+      result->_devices.push_back(info);
     }    
   }
   XT_VERIFY_ALSA(snd_device_name_free_hint(hints));
@@ -96,6 +103,12 @@ AlsaService::GetDefaultDeviceId(XtBool output, XtBool* valid, char* buffer, int3
 XtFault
 AlsaService::AggregateStream(XtAggregateStreamParams const* params, void* user, XtStream** stream) const
 {
+  for(auto i = 0; i < params->count; i++)
+    if((&dynamic_cast<AlsaDevice&>(*params->devices[i].device))->_info.type == XtAlsaType::OutputTimer)
+    {
+      XT_TRACE("Cannot use timer-scheduled devices in ALSA aggregation.");
+      return -ENODEV;
+    }
   bool mmap = XtiAlsaTypeIsMMap((&dynamic_cast<AlsaDevice&>(*params->devices[0].device))->_info.type);
   for(auto i = 1; i < params->count; i++)
     if(mmap != XtiAlsaTypeIsMMap((&dynamic_cast<AlsaDevice&>(*params->devices[i].device))->_info.type))
@@ -10,6 +10,7 @@
 #include <xt/backend/alsa/Private.hpp>
 
 #include <alsa/asoundlib.h>
+#include <atomic>
 #include <vector>
 #include <cstdint>
 
@@ -29,12 +30,24 @@ public XtBlockingStream
 {
   XtAlsaPcm _pcm;
   int32_t _frames;  
+  bool _canPause;
   XtAlsaType _type;
+  XtAlsaTimer _timer;
   uint64_t _processed;
   bool _alsaInterleaved;
   XtBuffers _alsaBuffers;
+  std::atomic<bool> _wake;
+  std::atomic<bool> _rewind;
+  snd_pcm_uframes_t _watermark;
   
   AlsaStream() = default;
+  void Rewind() override final;
+  void WakeMasterBuffer() override final;
+  XtFault SetBufferSize(double bufferSize) override final;
+  XtFault PauseSlaveBuffer(XtBool pause) override final;
+  XtFault Configure(XtFormat const* format, XtBool interleaved, double bufferSize);
+  XtFault BlockTimerBuffer();
+  XtFault ProcessTimerBuffer();
   XT_IMPLEMENT_STREAM_BASE();
   XT_IMPLEMENT_BLOCKING_STREAM();
   XT_IMPLEMENT_STREAM_BASE_SYSTEM(ALSA);
@@ -3,6 +3,10 @@
 #include <xt/backend/alsa/Shared.hpp>
 #include <xt/backend/alsa/Private.hpp>
 
+#include <sys/timerfd.h>
+#include <algorithm>
+#include <cerrno>
+
 void*
 AlsaStream::GetHandle() const
 { return _pcm.pcm; }
@@ -49,15 +53,201 @@ AlsaStream::StartSlaveBuffer()
   return 0;
 }
 
+// Hardware pause where supported. Otherwise the pcm is dropped and
+// prepared again right away, so resuming only needs to refill (output) 
+// and start (mmap) instead of the full stop/start sequence.
+XtFault
+AlsaStream::PauseSlaveBuffer(XtBool pause)
+{
+  XtFault fault;
+  auto state = snd_pcm_state(_pcm.pcm);
+  if(pause && _canPause && state == SND_PCM_STATE_RUNNING)
+    XT_VERIFY_ALSA(snd_pcm_pause(_pcm.pcm, 1));
+  else if(pause)
+  {
+    XT_VERIFY_ALSA(snd_pcm_drop(_pcm.pcm));
+    XT_VERIFY_ALSA(snd_pcm_prepare(_pcm.pcm));
+  }
+  else if(state == SND_PCM_STATE_PAUSED)
+    XT_VERIFY_ALSA(snd_pcm_pause(_pcm.pcm, 0));
+  else if(state == SND_PCM_STATE_PREPARED)
+  {
+    if(XtiAlsaTypeIsOutput(_type) && (fault = ProcessBuffer()) != 0) return fault;
+    if(XtiAlsaTypeIsMMap(_type) && snd_pcm_state(_pcm.pcm) == SND_PCM_STATE_PREPARED)
+      XT_VERIFY_ALSA(snd_pcm_start(_pcm.pcm));
+  }
+  return 0;
+}
+
+// Negotiates access and buffer size on hw params already restricted
+// to the stream format, then sizes the transfer buffers to match.
+XtFault
+AlsaStream::Configure(XtFormat const* format, XtBool interleaved, double bufferSize)
+{
+  snd_pcm_uframes_t min;
+  snd_pcm_uframes_t max;
+  snd_pcm_uframes_t buffer;
+  snd_pcm_sw_params_t* swParams;
+
+  snd_pcm_sw_params_alloca(&swParams);
+  _alsaInterleaved = interleaved;
+  auto access = XtiGetAlsaAccess(_type, interleaved);
+  if(snd_pcm_hw_params_set_access(_pcm.pcm, _pcm.params, access) != 0)
+  {
+    _alsaInterleaved = !interleaved;
+    access = XtiGetAlsaAccess(_type, !interleaved);
+    XT_VERIFY_ALSA(snd_pcm_hw_params_set_access(_pcm.pcm, _pcm.params, access));
+  }
+
+  XT_VERIFY_ALSA(snd_pcm_hw_params_get_buffer_size_min(_pcm.params, &min));
+  XT_VERIFY_ALSA(snd_pcm_hw_params_get_buffer_size_max(_pcm.params, &max));
+  buffer = bufferSize / 1000.0 * format->mix.rate;
+  buffer = std::clamp(buffer, min, max);
+  XT_VERIFY_ALSA(snd_pcm_hw_params_set_buffer_size_near(_pcm.pcm, _pcm.params, &buffer));  
+  XT_VERIFY_ALSA(snd_pcm_hw_params(_pcm.pcm, _pcm.params));
+  _canPause = snd_pcm_hw_params_can_pause(_pcm.params) != 0;
+
+  XT_VERIFY_ALSA(snd_pcm_sw_params_current(_pcm.pcm, swParams));
+  XT_VERIFY_ALSA(snd_pcm_sw_params_set_start_threshold(_pcm.pcm, swParams, buffer));
+  XT_VERIFY_ALSA(snd_pcm_sw_params_set_tstamp_mode(_pcm.pcm, swParams, SND_PCM_TSTAMP_ENABLE));
+  if(_type == XtAlsaType::OutputTimer)
+  {
+    XT_VERIFY_ALSA(snd_pcm_sw_params_set_avail_min(_pcm.pcm, swParams, buffer));
+    XT_VERIFY_ALSA(snd_pcm_sw_params_set_period_event(_pcm.pcm, swParams, 0));
+  }
+  XT_VERIFY_ALSA(snd_pcm_sw_params(_pcm.pcm, swParams));
+
+  snd_pcm_uframes_t watermark = XtiAlsaTimerWatermarkMs * format->mix.rate / 1000.0;
+  _watermark = std::min(watermark, buffer / 2);
+  _frames = buffer;
+  auto channels = format->channels.inputs + format->channels.outputs;
+  XtiInitBuffers(_alsaBuffers, format->mix.sample, channels, buffer);
+  return 0;
+}
+
+// Called on the stream thread with the pcm stopped (setup or prepared), 
+// so the existing handle is renegotiated without reopening the device.
+XtFault
+AlsaStream::SetBufferSize(double bufferSize)
+{
+  XT_VERIFY_ALSA(snd_pcm_hw_free(_pcm.pcm));
+  XT_VERIFY_ALSA(XtiAlsaInitHwParams(_type, &_params.format, &_pcm));
+  return Configure(&_params.format, _params.interleaved, bufferSize);
+}
+
+void
+AlsaStream::Rewind()
+{
+  if(_type != XtAlsaType::OutputTimer) return;
+  _rewind.store(true);
+  WakeMasterBuffer();
+}
+
+// The timer sleep may span most of the buffer. Expiring it right away
+// lets the runner pick up stop, pause, resize and close requests. The
+// flag covers a wake that lands before the sleep is armed.
+void
+AlsaStream::WakeMasterBuffer()
+{
+  itimerspec spec = { 0 };
+  if(_type != XtAlsaType::OutputTimer) return;
+  _wake.store(true);
+  spec.it_value.tv_nsec = 1;
+  XT_TRACE_IF(timerfd_settime(_timer.fd, 0, &spec, nullptr) != 0);
+}
+
 XtFault
 AlsaStream::BlockMasterBuffer(XtBool* ready)
 {
-  if(XtiAlsaTypeIsMMap(_type)) 
+  if(_type == XtAlsaType::OutputTimer)
+    XT_VERIFY_ALSA(BlockTimerBuffer());
+  else if(XtiAlsaTypeIsMMap(_type)) 
     XT_VERIFY_ALSA(snd_pcm_wait(_pcm.pcm, XtBlockingRunner::WaitTimeoutMs));
   *ready = XtTrue;
   return 0; 
 }
 
+XtFault
+AlsaStream::BlockTimerBuffer()
+{
+  uint64_t expired;
+  itimerspec spec = { 0 };
+  auto rate = _params.format.mix.rate;
+  auto available = snd_pcm_avail_update(_pcm.pcm);
+  if(_wake.exchange(false) || available < 0 || _rewind.load()) return 0;
+  auto queued = _frames - std::min<snd_pcm_uframes_t>(available, _frames);
+  if(queued <= _watermark) return 0;
+  uint64_t sleep = (queued - _watermark) * 1000000000ULL / rate;
+  spec.it_value.tv_sec = sleep / 1000000000ULL;
+  spec.it_value.tv_nsec = sleep % 1000000000ULL;
+  if(timerfd_settime(_timer.fd, 0, &spec, nullptr) != 0) return -errno;
+  if(_wake.exchange(false) || _rewind.load()) return 0;
+  if(read(_timer.fd, &expired, sizeof(expired)) == -1 && errno != EINTR) return -errno;
+  return 0;
+}
+
+XtFault
+AlsaStream::ProcessTimerBuffer()
+{
+  int err;
+  snd_timestamp_t stamp;
+  XtBuffer buffer = { 0 };
+  snd_pcm_status_t* status;
+  snd_pcm_uframes_t offset;
+  snd_pcm_uframes_t uframes;
+  snd_pcm_sframes_t rewound;
+  snd_pcm_sframes_t available;
+  snd_pcm_sframes_t rewindable;
+  snd_pcm_channel_area_t const* areas;
+  auto rate = _params.format.mix.rate;
+  snd_pcm_sframes_t guard = XtiAlsaTimerGuardMs * rate / 1000.0;
+
+  if(_rewind.exchange(false) && (rewindable = snd_pcm_rewindable(_pcm.pcm)) > guard)
+    if((rewound = snd_pcm_rewind(_pcm.pcm, rewindable - guard)) > 0)
+      _processed -= std::min(static_cast<uint64_t>(rewound), _processed);
+
+  snd_pcm_status_alloca(&status);
+  XT_VERIFY_ALSA(snd_pcm_status(_pcm.pcm, status));
+  snd_pcm_status_get_tstamp(status, &stamp);
+  buffer.timeValid = stamp.tv_sec != 0 || stamp.tv_usec != 0;
+  buffer.time = stamp.tv_sec * 1000.0 + stamp.tv_usec / 1000.0;
+
+  while(true)
+  {
+    if((available = snd_pcm_avail_update(_pcm.pcm)) < 0)
+    {
+      if(available == -EPIPE) OnXRun(_params.index);
+      XT_VERIFY_ALSA(snd_pcm_recover(_pcm.pcm, available, 1));
+      continue;
+    }
+    if(available == 0) break;
+    uframes = std::min<snd_pcm_uframes_t>(available, _frames);
+    if((err = snd_pcm_mmap_begin(_pcm.pcm, &areas, &offset, &uframes)) < 0)
+    {
+      if(err == -EPIPE) OnXRun(_params.index);
+      XT_VERIFY_ALSA(snd_pcm_recover(_pcm.pcm, err, 1));
+      continue;
+    }
+
+    buffer.frames = uframes;
+    buffer.position = _processed;
+    buffer.output = XtiGetAlsaMMapAddress(areas, 0, offset);
+    XT_VERIFY_ALSA(OnBuffer(_params.index, &buffer));
+    buffer.time += uframes * 1000.0 / rate;
+    _processed += uframes;
+
+    err = snd_pcm_mmap_commit(_pcm.pcm, offset, uframes);
+    if(err >= 0 && err != uframes) OnXRun(_params.index);
+    if(err >= 0) continue;
+    if(err == -EPIPE) OnXRun(_params.index);
+    XT_VERIFY_ALSA(snd_pcm_recover(_pcm.pcm, err, 1));
+  }
+
+  if(snd_pcm_state(_pcm.pcm) == SND_PCM_STATE_PREPARED && _runner->IsRunning())
+    XT_VERIFY_ALSA(snd_pcm_start(_pcm.pcm));
+  return 0;
+}
+
 XtFault 
 AlsaStream::ProcessBuffer()
 {
@@ -73,6 +263,7 @@ AlsaStream::ProcessBuffer()
   snd_pcm_channel_area_t const* areas;
   bool mmap = XtiAlsaTypeIsMMap(_type);
   bool output = XtiAlsaTypeIsOutput(_type);
+  if(_type == XtAlsaType::OutputTimer) return ProcessTimerBuffer();
 
   snd_pcm_status_alloca(&status);
   XT_VERIFY_ALSA(snd_pcm_status(_pcm.pcm, status));
@@ -7,6 +7,9 @@
 XtFault
 AsioService::GetFormatFault() const
 { return XT_ASE_Format; }
+XtFault
+AsioService::GetUnsupportedFault() const
+{ return ASE_InvalidMode; }
 
 XtFault
 AsioService::OpenDeviceList(XtEnumFlags flags, XtDeviceList** list) const
@@ -8,6 +8,9 @@
 XtFault
 DSoundService::GetFormatFault() const
 { return DSERR_BADFORMAT; }
+XtFault
+DSoundService::GetUnsupportedFault() const
+{ return DSERR_UNSUPPORTED; }
 
 XtServiceCaps 
 DSoundService::GetCapabilities() const
@@ -0,0 +1,107 @@
+#if XT_ENABLE_FILE
+#include <xt/blocking/Device.hpp>
+#include <xt/backend/file/Shared.hpp>
+#include <xt/backend/file/Private.hpp>
+
+#include <memory>
+#include <string>
+#include <cmath>
+
+FileDevice::
+FileDevice(XtFileDeviceInfo const& info, std::shared_ptr<XtFileMapping> const& mapping): 
+_info(info), _mapping(mapping) { }
+
+void*
+FileDevice::GetHandle() const
+{ return nullptr; }
+XtFault
+FileDevice::ShowControlPanel()
+{ return 0; }
+XtFault 
+FileDevice::SupportsAccess(XtBool interleaved, XtBool* supports) const 
+{ *supports = interleaved; return 0; }
+
+XtFault 
+FileDevice::GetChannelCount(XtBool output, int32_t* count) const 
+{ 
+  if(output != _info.output) *count = 0;
+  else *count = output? XtiFileMaxChannels: _mapping->info.channels;
+  return 0; 
+}
+
+XtFault 
+FileDevice::GetMix(XtBool* valid, XtMix* mix) const
+{
+  *valid = XtTrue;
+  if(!_info.output) *mix = _mapping->info.mix;
+  else mix->rate = XtiFileDefaultRate, mix->sample = XtiFileDefaultSample;
+  return 0;
+}
+
+XtFault 
+FileDevice::GetBufferSize(XtFormat const* format, XtBufferSize* size) const
+{
+  size->min = XtiFileMinBufferSize;
+  size->max = XtiFileMaxBufferSize;
+  size->current = XtiFileDefaultBufferSize;
+  return 0;
+}
+
+XtFault 
+FileDevice::GetChannelName(XtBool output, int32_t index, char* buffer, int32_t* size) const
+{
+  auto name = "Channel " + std::to_string(index + 1);
+  XtiCopyString(name.c_str(), buffer, size);
+  return 0;
+}
+
+XtFault 
+FileDevice::SupportsFormat(XtFormat const* format, XtBool* supports) const
+{
+  auto const& mix = format->mix;
+  auto const& channels = format->channels;
+  if(channels.inMask != 0 || channels.outMask != 0) return 0;
+  if(_info.output)
+  {
+    if(channels.inputs > 0) return 0;
+    if(mix.rate < XtiFileMinRate || mix.rate > XtiFileMaxRate) return 0;
+    if(channels.outputs < 1 || channels.outputs > XtiFileMaxChannels) return 0;
+  } else
+  {
+    auto const& info = _mapping->info;
+    if(channels.outputs > 0) return 0;
+    if(channels.inputs != info.channels) return 0;
+    if(mix.rate != info.mix.rate || mix.sample != info.mix.sample) return 0;
+  }
+  *supports = XtTrue;
+  return 0;
+}
+
+XtFault 
+FileDevice::OpenBlockingStream(XtBlockingParams const* params, XtBlockingStream** stream)
+{
+  XtFault fault;
+  auto const& mix = params->format.mix;
+  auto const& channels = params->format.channels;
+  double df = params->bufferSize / 1000.0 * mix.rate;
+  int32_t frames = static_cast<int32_t>(std::ceil(df));
+  int32_t frameSize = (channels.inputs + channels.outputs) * XtiGetSampleSize(mix.sample);
+
+  auto result = std::make_unique<FileStream>();
+  result->_position = 0;
+  result->_frames = frames;
+  result->_clockPosition = 0;
+  result->_mapping = _mapping;
+  result->_output = _info.output;
+  result->_frameSize = frameSize;
+  result->_freewheel.store(false);
+  if(_info.output)
+  {
+    result->_audio = std::vector<uint8_t>(static_cast<size_t>(frames * frameSize), 0);
+    if((fault = result->_writer.Open(_info.path.c_str(), mix, channels.outputs)) != 0) return fault;
+  }
+  *stream = result.release();
+  return 0;
+}
+
+#endif // XT_ENABLE_FILE
@@ -0,0 +1,32 @@
+#if XT_ENABLE_FILE
+#include <xt/backend/file/Shared.hpp>
+#include <xt/backend/file/Private.hpp>
+
+#include <errno.h>
+
+XtFault
+FileDeviceList::GetCount(int32_t* count) const
+{ *count = 0; return 0; }
+XtFault 
+FileDeviceList::GetId(int32_t index, char* buffer, int32_t* size) const
+{ return ENODEV; }
+
+XtFault
+FileDeviceList::GetName(char const* id, char* buffer, int32_t* size) const
+{
+  XtFileDeviceInfo info;
+  if(!XtiParseFileDeviceInfo(id, &info)) return ENODEV;
+  XtiCopyString(info.path.c_str(), buffer, size);
+  return 0;
+}
+
+XtFault
+FileDeviceList::GetCapabilities(char const* id, XtDeviceCaps* capabilities) const
+{ 
+  XtFileDeviceInfo info;
+  if(!XtiParseFileDeviceInfo(id, &info)) return ENODEV;
+  *capabilities = info.output? XtDeviceCapsOutput: XtDeviceCapsInput;
+  return 0;
+}
+
+#endif // XT_ENABLE_FILE
@@ -0,0 +1,61 @@
+#if XT_ENABLE_FILE
+#include <xt/shared/Linux.hpp>
+#include <xt/backend/file/Shared.hpp>
+#include <xt/backend/file/Private.hpp>
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <memory>
+#include <sstream>
+#include <cstring>
+
+std::unique_ptr<XtService>
+XtiCreateFileService()
+{ return std::make_unique<FileService>(); }
+
+XtServiceError
+XtiGetFileError(XtFault fault)
+{
+  XtServiceError result;
+  result.text = strerror(fault);
+  result.cause = fault == ENODATA? XtCauseEndpoint: XtiGetPosixFaultCause(fault);
+  return result;
+}
+
+std::string
+XtiGetFileDeviceId(XtFileDeviceInfo const& info)
+{
+  std::ostringstream sstream;
+  sstream << info.path << ",TYPE=" << (info.output? 1: 0);
+  return sstream.str();
+}
+
+bool
+XtiParseFileDeviceInfo(std::string const& id, XtFileDeviceInfo* info)
+{
+  if(id.length() < 8) return false;
+  if(id.substr(id.length() - 7, 6) != ",TYPE=") return false;
+  char typeCode = id[id.length() - 1];
+  if(typeCode != '0' && typeCode != '1') return false;
+  info->output = typeCode == '1';
+  info->path = id.substr(0, id.length() - 7);
+  return true;
+}
+
+XtFault
+XtiOpenFileMapping(char const* path, XtFileMapping* mapping)
+{
+  struct stat st;
+  if((mapping->fd = open(path, O_RDONLY | O_CLOEXEC)) == -1) return errno;
+  if(fstat(mapping->fd, &st) != 0) return errno;
+  if(st.st_size == 0) return EINVAL;
+  mapping->size = static_cast<uint64_t>(st.st_size);
+  mapping->data = mmap(nullptr, mapping->size, PROT_READ, MAP_SHARED, mapping->fd, 0);
+  if(mapping->data == MAP_FAILED) return errno;
+  XT_TRACE_IF(madvise(mapping->data, mapping->size, MADV_SEQUENTIAL) != 0);
+  if(!XtiParseWav(mapping->data, mapping->size, &mapping->info)) return EINVAL;
+  return 0;
+}
+
+#endif // XT_ENABLE_FILE
@@ -0,0 +1,58 @@
+#ifndef XT_FILE_PRIVATE_HPP
+#define XT_FILE_PRIVATE_HPP
+#if XT_ENABLE_FILE
+#include <xt/shared/Wav.hpp>
+#include <xt/shared/Shared.hpp>
+
+#include <sys/mman.h>
+#include <unistd.h>
+#include <string>
+#include <cstdint>
+
+inline int32_t const
+XtiFileMinRate = 1;
+inline int32_t const
+XtiFileMaxRate = 384000;
+inline int32_t const
+XtiFileMaxChannels = 64;
+inline int32_t const
+XtiFileDefaultRate = 48000;
+inline XtSample const
+XtiFileDefaultSample = XtSampleFloat32;
+
+inline double const
+XtiFileMinBufferSize = 1.0;
+inline double const
+XtiFileMaxBufferSize = 2000.0;
+inline double const
+XtiFileDefaultBufferSize = 10.0;
+
+// Device ids are "<path>,TYPE=0" (read) and "<path>,TYPE=1" (write).
+struct XtFileDeviceInfo
+{
+  bool output;
+  std::string path;
+};
+
+struct XtFileMapping
+{
+  int fd;
+  void* data;
+  uint64_t size;
+  XtWavInfo info;
+
+  XtFileMapping(XtFileMapping const&) = delete;
+  XtFileMapping& operator=(XtFileMapping const&) = delete;
+  XtFileMapping(): fd(-1), data(MAP_FAILED), size(0), info() { }
+  ~XtFileMapping() { if(data != MAP_FAILED) munmap(data, size); if(fd != -1) close(fd); }
+};
+
+std::string
+XtiGetFileDeviceId(XtFileDeviceInfo const& info);
+bool
+XtiParseFileDeviceInfo(std::string const& id, XtFileDeviceInfo* info);
+XtFault
+XtiOpenFileMapping(char const* path, XtFileMapping* mapping);
+
+#endif // XT_ENABLE_FILE
+#endif // XT_FILE_PRIVATE_HPP
@@ -0,0 +1,49 @@
+#if XT_ENABLE_FILE
+#include <xt/backend/file/Shared.hpp>
+#include <xt/backend/file/Private.hpp>
+
+#include <errno.h>
+#include <memory>
+
+XtFault
+FileService::GetFormatFault() const
+{ return EINVAL; }
+XtFault
+FileService::GetUnsupportedFault() const
+{ return ENOTSUP; }
+XtFault
+FileService::OpenDeviceList(XtEnumFlags flags, XtDeviceList** list) const
+{ *list = new FileDeviceList; return 0; }
+
+XtServiceCaps 
+FileService::GetCapabilities() const
+{ 
+  auto result = XtServiceCapsTime
+  | XtServiceCapsFreewheel
+  | XtServiceCapsBufferSize
+  | XtServiceCapsPause
+  | XtServiceCapsAggregation;
+  return static_cast<XtServiceCaps>(result); 
+}
+
+XtFault
+FileService::OpenDevice(char const* id, XtDevice** device) const
+{
+  XtFault fault;
+  XtFileDeviceInfo info;
+  std::shared_ptr<XtFileMapping> mapping;
+  if(!XtiParseFileDeviceInfo(id, &info)) return ENODEV;
+  if(!info.output)
+  {
+    mapping = std::make_shared<XtFileMapping>();
+    if((fault = XtiOpenFileMapping(info.path.c_str(), mapping.get())) != 0) return fault;
+  }
+  *device = new FileDevice(info, mapping);
+  return 0;
+}
+
+XtFault
+FileService::GetDefaultDeviceId(XtBool output, XtBool* valid, char* buffer, int32_t* size) const
+{ *valid = XtFalse; return 0; }
+
+#endif // XT_ENABLE_FILE
@@ -0,0 +1,65 @@
+#ifndef XT_FILE_SHARED_HPP
+#define XT_FILE_SHARED_HPP
+#if XT_ENABLE_FILE
+#include <xt/private/Device.hpp>
+#include <xt/private/Stream.hpp>
+#include <xt/private/Service.hpp>
+#include <xt/blocking/Device.hpp>
+#include <xt/blocking/Stream.hpp>
+#include <xt/private/DeviceList.hpp>
+#include <xt/backend/file/Private.hpp>
+
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+struct FileService final: 
+public XtService 
+{
+  XT_IMPLEMENT_SERVICE(File);
+};
+
+struct FileDevice final: 
+public XtBlockingDevice
+{
+  XtFileDeviceInfo const _info;
+  std::shared_ptr<XtFileMapping> const _mapping;
+  XT_IMPLEMENT_DEVICE();
+  XT_IMPLEMENT_DEVICE_BLOCKING();
+  XT_IMPLEMENT_DEVICE_BASE(File);
+  FileDevice(XtFileDeviceInfo const& info, std::shared_ptr<XtFileMapping> const& mapping);
+};
+
+struct FileStream final:
+public XtBlockingStream 
+{
+  bool _output;
+  int32_t _frames;
+  int32_t _frameSize;
+  uint64_t _position;
+  uint64_t _clockPosition;
+  std::atomic<bool> _freewheel;
+  std::vector<uint8_t> _audio;
+  XtWavWriter _writer;
+  std::shared_ptr<XtFileMapping> _mapping;
+  std::chrono::steady_clock::time_point _clockStart;
+  
+  FileStream() = default;
+  XT_IMPLEMENT_STREAM_BASE();
+  XT_IMPLEMENT_BLOCKING_STREAM();
+  XT_IMPLEMENT_STREAM_BASE_SYSTEM(File);
+  XtFault SetFreewheel(XtBool freewheel) override final;
+  XtFault SetBufferSize(double bufferSize) override final;
+};
+
+struct FileDeviceList final:
+public XtDeviceList 
+{
+  XT_IMPLEMENT_DEVICE_LIST(File);
+};
+
+#endif // XT_ENABLE_FILE
+#endif // XT_FILE_SHARED_HPP
@@ -0,0 +1,105 @@
+#if XT_ENABLE_FILE
+#include <xt/backend/file/Shared.hpp>
+#include <xt/backend/file/Private.hpp>
+
+#include <errno.h>
+#include <thread>
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+
+void
+FileStream::StopMasterBuffer() { }
+void*
+FileStream::GetHandle() const
+{ return nullptr; }
+XtFault
+FileStream::StartSlaveBuffer()
+{ return 0; }
+XtFault
+FileStream::PrefillOutputBuffer() 
+{ return 0; }
+XtFault
+FileStream::GetFrames(int32_t* frames) const
+{ *frames = _frames; return 0; }
+XtFault
+FileStream::GetLatency(XtLatency* latency) const
+{ return 0; }
+XtFault
+FileStream::SetFreewheel(XtBool freewheel)
+{ _freewheel.store(freewheel != XtFalse); return 0; }
+
+XtFault
+FileStream::SetBufferSize(double bufferSize)
+{
+  double size = std::clamp(bufferSize, XtiFileMinBufferSize, XtiFileMaxBufferSize);
+  _frames = static_cast<int32_t>(std::ceil(size / 1000.0 * _params.format.mix.rate));
+  if(_output) _audio.assign(static_cast<size_t>(_frames * _frameSize), 0);
+  return 0;
+}
+
+void
+FileStream::StopSlaveBuffer()
+{ if(_output) XT_TRACE_IF(_writer.Flush() != 0); }
+
+XtFault
+FileStream::StartMasterBuffer()
+{
+  _clockPosition = _position;
+  _clockStart = std::chrono::steady_clock::now();
+  return 0;
+}
+
+// Clocked streams release one buffer per buffer duration, measured 
+// from the start (or the end of freewheeling). Freewheeling output
+// only waits for the writer thread to make room in the ring.
+XtFault
+FileStream::BlockMasterBuffer(XtBool* ready) 
+{
+  *ready = XtTrue;
+  if(_freewheel.load())
+  {
+    XtFault fault = StartMasterBuffer();
+    size_t bytes = static_cast<size_t>(_frames * _frameSize);
+    if(!_output || _writer.GetFree() >= bytes) return fault;
+    *ready = XtFalse;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return static_cast<XtFault>(_writer._fault.load());
+  }
+  double rate = _params.format.mix.rate;
+  std::chrono::duration<double> elapsed((_position - _clockPosition) / rate);
+  std::this_thread::sleep_until(_clockStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(elapsed));
+  return 0;
+}
+
+XtFault 
+FileStream::ProcessBuffer()
+{
+  XtFault fault;
+  XtBuffer buffer = { 0 };
+  buffer.timeValid = XtTrue;
+  buffer.position = _position;
+  buffer.time = _position * 1000.0 / _params.format.mix.rate;
+
+  if(!_output)
+  {
+    auto const& info = _mapping->info;
+    if(_position >= info.frames) return ENODATA;
+    auto data = static_cast<uint8_t const*>(_mapping->data) + info.offset;
+    buffer.input = data + _position * _frameSize;
+    buffer.frames = static_cast<int32_t>(std::min<uint64_t>(_frames, info.frames - _position));
+    if((fault = OnBuffer(_params.index, &buffer)) != 0) return fault;
+    _position += buffer.frames;
+    return 0;
+  }
+
+  if((fault = static_cast<XtFault>(_writer._fault.load())) != 0) return fault;
+  buffer.frames = _frames;
+  buffer.output = _audio.data();
+  if((fault = OnBuffer(_params.index, &buffer)) != 0) return fault;
+  if(!_writer.Write(_audio.data(), _audio.size())) OnXRun(_params.index);
+  _position += _frames;
+  return 0;
+}
+
+#endif // XT_ENABLE_FILE
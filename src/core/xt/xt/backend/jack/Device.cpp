@@ -4,11 +4,201 @@
 #include <xt/backend/jack/Private.hpp>
 
 #include <memory>
+#include <thread>
 #include <utility>
+#include <algorithm>
 
 JackDevice::
 JackDevice(XtJackClient&& jc):
-_jc(std::move(jc)) { }
+_ports(), _clockValid(false), _clockTime(0.0), _clockPosition(0), _clockFrames(0),
+_clockFreewheeled(false), _clockTimeOffset(0.0), _clockPositionOffset(0),
+_lock(), _closing(0), _nextRate(0), _nextFrames(0), _reconfigure(0), _reconfigurer(),
+_freewheel(0), _readers(0), _streams(new std::vector<JackStream*>), _jc(std::move(jc)) { }
+
+// Close the client first so no callback still reads the list.
+JackDevice::
+~JackDevice()
+{
+  if(_jc.jc != nullptr) jack_client_close(std::exchange(_jc.jc, nullptr));
+  Signal(_closing, 1);
+  if(_reconfigurer.joinable()) _reconfigurer.join();
+  delete _streams.load();
+}
+
+std::vector<std::string> const&
+JackDevice::GetPorts(XtBool output) const
+{ return XtiJackGetPorts(_jc.jc, _ports, output); }
+
+void
+JackDevice::AddStream(JackStream* stream)
+{
+  std::lock_guard<std::mutex> lock(_lock);
+  auto streams = new std::vector<JackStream*>(*_streams.load());
+  streams->push_back(stream);
+  PublishStreams(streams);
+}
+
+void
+JackDevice::RemoveStream(JackStream* stream)
+{
+  std::lock_guard<std::recursive_mutex> notifying(_notifying);
+  std::lock_guard<std::mutex> lock(_lock);
+  auto streams = new std::vector<JackStream*>(*_streams.load());
+  streams->erase(std::remove(streams->begin(), streams->end(), stream), streams->end());
+  PublishStreams(streams);
+}
+
+// Once this returns no callback still uses anything unpublished before.
+void
+JackDevice::Synchronize()
+{
+  while(_readers.load() != 0) std::this_thread::yield();
+}
+
+void
+JackDevice::PublishStreams(std::vector<JackStream*> const* streams)
+{
+  auto previous = _streams.exchange(streams);
+  Synchronize();
+  delete previous;
+}
+
+// Changes are rare, so the JACK callbacks may take the signal lock.
+void
+JackDevice::Signal(std::atomic_int& value, int32_t next)
+{
+  {
+    std::lock_guard<std::mutex> guard(_signalLock);
+    value.store(next);
+    _reconfigure.store(1);
+  }
+  _signal.notify_one();
+}
+
+bool
+JackDevice::HasStream(JackStream* stream)
+{
+  bool result = false;
+  ForEachStream([stream, &result](JackStream* s) { result |= s == stream; });
+  return result;
+}
+
+// Applies buffer size and sample rate changes off the JACK threads. New
+// buffers are published under the lock, handlers run after releasing
+// it so they may open and close streams. A stream closed by an earlier
+// handler is skipped.
+void
+JackDevice::RunReconfigure(JackDevice* device)
+{
+  std::vector<JackStream*> notify;
+  auto pred = [device] { return device->_closing.load() != 0 || device->_reconfigure.load() != 0; };
+  while(true)
+  {
+    {
+      std::unique_lock<std::mutex> guard(device->_signalLock);
+      device->_signal.wait(guard, pred);
+      if(device->_closing.load() != 0) return;
+      device->_reconfigure.store(0);
+    }
+    notify.clear();
+    int32_t rate = device->_nextRate.load();
+    int32_t frames = device->_nextFrames.load();
+    std::lock_guard<std::recursive_mutex> notifying(device->_notifying);
+    {
+      std::lock_guard<std::mutex> lock(device->_lock);
+      for(auto stream: *device->_streams.load())
+        if(stream->Reconfigure(frames, rate)) notify.push_back(stream);
+    }
+    for(auto stream: notify)
+      if(device->HasStream(stream)) stream->OnReconfigure(frames, rate);
+  }
+}
+
+int 
+JackDevice::XRunCallback(void* arg)
+{
+  auto device = static_cast<JackDevice*>(arg);
+  device->ForEachStream([](JackStream* stream) {
+    if(stream->_running.load() == 1) stream->OnXRun(-1); });
+  return 0;
+}
+
+void
+JackDevice::ShutdownCallback(void* arg)
+{
+  auto device = static_cast<JackDevice*>(arg);
+  device->ForEachStream([](JackStream* stream) {
+    if(XtiCompareExchange(stream->_running, 1, 0)) stream->OnRunning(XtFalse, 0); });
+}
+
+// Only records the change, RunReconfigure allocates and notifies.
+int
+JackDevice::BufferSizeCallback(jack_nframes_t frames, void* arg)
+{
+  auto device = static_cast<JackDevice*>(arg);
+  device->Signal(device->_nextFrames, static_cast<int32_t>(frames));
+  return 0;
+}
+
+int
+JackDevice::SampleRateCallback(jack_nframes_t rate, void* arg)
+{
+  auto device = static_cast<JackDevice*>(arg);
+  device->Signal(device->_nextRate, static_cast<int32_t>(rate));
+  return 0;
+}
+
+void
+JackDevice::FreewheelCallback(int starting, void* arg)
+{ static_cast<JackDevice*>(arg)->_freewheel.store(starting != 0? 1: 0); }
+
+// All streams opened on a device share its client, so jackd schedules
+// a single graph node per device. Streams are serviced in the order
+// they were opened. Opening or closing a stream publishes a new stream
+// list, so no cycle is ever skipped for the other streams.
+int 
+JackDevice::ProcessCallback(jack_nframes_t frames, void* arg)
+{
+  XtBuffer cycle = { 0 };
+  cycle.frames = frames;
+  auto device = static_cast<JackDevice*>(arg);
+
+  float period;
+  jack_time_t time, next;
+  jack_nframes_t position;
+  double rate = jack_get_sample_rate(device->_jc.jc);
+  uint64_t nextPosition = device->_clockPosition + device->_clockFrames;
+  double nextTime = device->_clockTime + device->_clockFrames * 1000.0 / rate;
+  if(device->_freewheel.load() == 0 && jack_get_cycle_times(device->_jc.jc, &position, &time, &next, &period) == 0)
+  {
+    cycle.timeValid = XtTrue;
+    cycle.position = position + device->_clockPositionOffset;
+    cycle.time = time / 1000.0 + device->_clockTimeOffset;
+    // Freewheeling runs ahead of the server clock. Once it ends, offset
+    // the server clock from then on so neither goes backwards.
+    if(device->_clockFreewheeled && device->_clockValid)
+    {
+      if(cycle.time < nextTime) device->_clockTimeOffset += nextTime - cycle.time, cycle.time = nextTime;
+      if(cycle.position < nextPosition) device->_clockPositionOffset += nextPosition - cycle.position, cycle.position = nextPosition;
+    }
+    device->_clockFreewheeled = false;
+  } else if(device->_clockValid)
+  {
+    // The server clock does not advance while freewheeling, so
+    // extrapolate from the last cycle using the frames processed.
+    cycle.timeValid = XtTrue;
+    cycle.time = nextTime;
+    cycle.position = nextPosition;
+    device->_clockFreewheeled = true;
+  }
+
+  device->_clockFrames = frames;
+  device->_clockTime = cycle.time;
+  device->_clockPosition = cycle.position;
+  device->_clockValid = cycle.timeValid != XtFalse;
+  device->ForEachStream([&cycle](JackStream* stream) { stream->ProcessBuffer(cycle); });
+  return 0;
+}
 
 void*
 JackDevice::GetHandle() const
@@ -18,7 +208,7 @@ JackDevice::ShowControlPanel()
 { return 0; }
 XtFault 
 JackDevice::GetChannelCount(XtBool output, int32_t* count) const
-{ *count = XtiJackCountPorts(_jc.jc, output); return 0; }
+{ *count = static_cast<int32_t>(GetPorts(output).size()); return 0; }
 XtFault
 JackDevice::SupportsAccess(XtBool interleaved, XtBool* supports) const
 { *supports = !interleaved; return 0; }
@@ -38,11 +228,13 @@ JackDevice::SupportsFormat(const XtFormat* format, XtBool* supports) const
   auto const& channels = format->channels;
   if(format->mix.sample != XtSampleFloat32) return 0;
   if(format->mix.rate != jack_get_sample_rate(_jc.jc)) return 0;
-  if(channels.inputs > XtiJackCountPorts(_jc.jc, XtFalse)) return 0;
-  if(channels.outputs > XtiJackCountPorts(_jc.jc, XtTrue)) return 0;
-  for(int32_t i = XtiJackCountPorts(_jc.jc, XtFalse); i < 64; i++)
+  int32_t inputs = static_cast<int32_t>(GetPorts(XtFalse).size());
+  int32_t outputs = static_cast<int32_t>(GetPorts(XtTrue).size());
+  if(channels.inputs > inputs) return 0;
+  if(channels.outputs > outputs) return 0;
+  for(int32_t i = inputs; i < 64; i++)
     if((format->channels.inMask & (1ULL << i)) != 0) return 0;
-  for(int32_t i = XtiJackCountPorts(_jc.jc, XtTrue); i < 64; i++)
+  for(int32_t i = outputs; i < 64; i++)
     if((format->channels.outMask & (1ULL << i)) != 0) return 0;
   *supports = XtTrue;
   return 0;
@@ -61,10 +253,9 @@ JackDevice::GetBufferSize(XtFormat const* format, XtBufferSize* size) const
 XtFault
 JackDevice::GetChannelName(XtBool output, int32_t index, char* buffer, int32_t* size) const
 {
-  unsigned long flag = output? JackPortIsInput: JackPortIsOutput;
-  XtJackPtr<const char*> ports(jack_get_ports(_jc.jc, nullptr, JACK_DEFAULT_AUDIO_TYPE, flag));
-  if(index >= XtiJackCountPorts(_jc.jc, output)) return ENODEV;
-  XtiCopyString(ports.p[index], buffer, size);
+  auto const& ports = GetPorts(output);
+  if(index >= static_cast<int32_t>(ports.size())) return ENODEV;
+  XtiCopyString(ports[index].c_str(), buffer, size);
   return 0;
 }
 
@@ -72,28 +263,31 @@ XtFault
 JackDevice::OpenStreamCore(XtDeviceStreamParams const* params, XtStream** stream)
 {  
   XtFault fault;
-  auto id = XtPlatform::instance->_id.c_str();
-  jack_client_t* client = jack_client_open(id, JackNoStartServer, nullptr);
-  if(client == nullptr) return ESRCH;
-  XtJackClient jc(client);
-  
+  jack_client_t* client = _jc.jc;
   std::vector<XtJackPort> inputs;
   std::vector<XtJackPort> outputs;
   auto const& channels = params->format.channels;
-  if((fault = XtiJackCreatePorts(client, channels.inputs, channels.inMask, JackPortIsInput, inputs)) != 0) return fault;
-  if((fault = XtiJackCreatePorts(client, channels.outputs, channels.outMask, JackPortIsOutput, outputs)) != 0) return fault;
+  auto const& sources = GetPorts(XtFalse);
+  auto const& targets = GetPorts(XtTrue);
+  if((fault = XtiJackCreatePorts(client, channels.inputs, channels.inMask, JackPortIsInput, sources, inputs)) != 0) return fault;
+  if((fault = XtiJackCreatePorts(client, channels.outputs, channels.outMask, JackPortIsOutput, targets, outputs)) != 0) return fault;
 
-  size_t sampleSize = XtiGetSampleSize(params->format.mix.sample);
   size_t bufferFrames = jack_get_buffer_size(client);
-  auto result = std::make_unique<JackStream>(std::move(jc));
+  auto result = std::make_unique<JackStream>(this);
+  auto buffers = std::make_unique<XtJackBuffers>();
+  buffers->frames = static_cast<int32_t>(bufferFrames);
+  XtiInitIOBuffers(buffers->buffers, &params->format, bufferFrames);
+  result->_params = *params;
+  result->_frames = static_cast<int32_t>(bufferFrames);
+  result->_rate.store(params->format.mix.rate);
+  result->_published.store(buffers.release());
   result->_running.store(0);
   result->_insideCallback.store(0);
   result->_inputs = std::move(inputs);
   result->_outputs = std::move(outputs);
   result->_inputChannels = std::vector<void*>(static_cast<size_t>(channels.inputs), nullptr);
   result->_outputChannels = std::vector<void*>(static_cast<size_t>(channels.outputs), nullptr);
-  if((fault = jack_set_xrun_callback(client, &JackStream::XRunCallback, result.get())) != 0) return fault;
-  if((fault = jack_set_process_callback(client, &JackStream::ProcessCallback, result.get())) != 0) return fault;
+  AddStream(result.get());
   *stream = result.release();
   return 0;
 }
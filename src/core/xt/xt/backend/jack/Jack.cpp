@@ -25,18 +25,43 @@ XtiGetJackError(XtFault fault)
   return result;
 }
 
-int32_t
-XtiJackCountPorts(jack_client_t* client, XtBool output)
+int
+XtiJackOnGraphOrder(void* arg)
 {
-  int32_t count = 0;
-  unsigned long flag = output? JackPortIsInput: JackPortIsOutput;
-  XtJackPtr<char const*> ports(jack_get_ports(client, nullptr, JACK_DEFAULT_AUDIO_TYPE, flag));
-  while(ports.p[count] != nullptr) count++;
-  return count;
+  static_cast<XtJackPortCache*>(arg)->dirty.store(1);
+  return 0;
+}
+
+void
+XtiJackOnPortRegistration(jack_port_id_t port, int registered, void* arg)
+{ static_cast<XtJackPortCache*>(arg)->dirty.store(1); }
+
+XtFault
+XtiJackWatchPorts(jack_client_t* jc, XtJackPortCache* cache)
+{
+  XtFault fault;
+  if((fault = jack_set_graph_order_callback(jc, &XtiJackOnGraphOrder, cache)) != 0) return fault;
+  return jack_set_port_registration_callback(jc, &XtiJackOnPortRegistration, cache);
+}
+
+std::vector<std::string> const&
+XtiJackGetPorts(jack_client_t* jc, XtJackPortCache& cache, XtBool output)
+{
+  if(XtiCompareExchange(cache.dirty, 1, 0))
+  {
+    cache.inputs.clear();
+    cache.outputs.clear();
+    XtJackPtr<char const*> inputs(jack_get_ports(jc, nullptr, JACK_DEFAULT_AUDIO_TYPE, JackPortIsOutput));
+    XtJackPtr<char const*> outputs(jack_get_ports(jc, nullptr, JACK_DEFAULT_AUDIO_TYPE, JackPortIsInput));
+    for(size_t i = 0; inputs.p[i] != nullptr; i++) cache.inputs.emplace_back(inputs.p[i]);
+    for(size_t i = 0; outputs.p[i] != nullptr; i++) cache.outputs.emplace_back(outputs.p[i]);
+  }
+  return output? cache.outputs: cache.inputs;
 }
 
 XtFault
-XtiJackCreatePorts(jack_client_t* jc, uint32_t channels, uint64_t mask, unsigned long flag, std::vector<XtJackPort>& result)
+XtiJackCreatePorts(jack_client_t* jc, uint32_t channels, uint64_t mask, unsigned long flag, 
+  std::vector<std::string> const& connectTo, std::vector<XtJackPort>& result)
 {
   char const* type = JACK_DEFAULT_AUDIO_TYPE;
   std::string name = flag == JackPortIsInput? "inputs": "outputs";
@@ -50,13 +75,11 @@ XtiJackCreatePorts(jack_client_t* jc, uint32_t channels, uint64_t mask, unsigned
     result.emplace_back(XtJackPort(jc, port));
   }
 
-  unsigned long jackFlag = flag == JackPortIsInput? JackPortIsOutput: JackPortIsInput;
-  XtJackPtr<const char*> ports(jack_get_ports(jc, nullptr, type, jackFlag));
   if(mask == 0) for(int32_t i = 0; i < channels; i++)
-    result[i].connectTo = ports.p[i];
+    result[i].connectTo = connectTo[i];
   else for(int32_t i = 0, j = 0; i < 64; i++)
     if(mask & (1ULL << i))
-      result[j++].connectTo = ports.p[i];
+      result[j++].connectTo = connectTo[i];
   return 0;
 }
 
@@ -2,6 +2,8 @@
 #define XT_JACK_PRIVATE_HPP
 #if XT_ENABLE_JACK
 #include <jack/jack.h>
+#include <atomic>
+#include <string>
 #include <vector>
 #include <cstdint>
 
@@ -46,25 +48,46 @@ struct XtJackPort
 {
   jack_port_t* port;
   jack_client_t* jc;
-  char const* connectTo;
+  std::string connectTo;
 
   XtJackPort(XtJackPort const&) = delete;
   XtJackPort& operator=(XtJackPort const&) = delete;
   ~XtJackPort() { if(port != nullptr) jack_port_unregister(jc, port); }
 
-  XtJackPort(XtJackPort&& rhs): port(rhs.port), jc(rhs.jc), connectTo(rhs.connectTo) { rhs.port = nullptr; }
-  XtJackPort& operator=(XtJackPort&& rhs) { jc = rhs.jc; port = rhs.port; connectTo = rhs.connectTo; rhs.port = nullptr; return *this; }
-  XtJackPort(jack_client_t* jc, jack_port_t* port): port(port), jc(jc), connectTo(nullptr) { XT_ASSERT(jc != nullptr); XT_ASSERT(port != nullptr); }
+  XtJackPort(XtJackPort&& rhs): port(rhs.port), jc(rhs.jc), connectTo(std::move(rhs.connectTo)) { rhs.port = nullptr; }
+  XtJackPort& operator=(XtJackPort&& rhs) { jc = rhs.jc; port = rhs.port; connectTo = std::move(rhs.connectTo); rhs.port = nullptr; return *this; }
+  XtJackPort(jack_client_t* jc, jack_port_t* port): port(port), jc(jc), connectTo() { XT_ASSERT(jc != nullptr); XT_ASSERT(port != nullptr); }
+};
+
+// Audio ports of all clients, refreshed lazily after JACK reports
+// port registrations or graph changes. Inputs are ports we can read
+// from (JackPortIsOutput), outputs are ports we can write to.
+struct XtJackPortCache
+{
+  std::atomic_int dirty;
+  std::vector<std::string> inputs;
+  std::vector<std::string> outputs;
+
+  XtJackPortCache(XtJackPortCache const&) = delete;
+  XtJackPortCache& operator=(XtJackPortCache const&) = delete;
+  XtJackPortCache(): dirty(1), inputs(), outputs() { }
 };
 
 void
 XtiJackSilentCallback(char const*);
 void
 XtiJackErrorCallback(char const* msg);
-int32_t
-XtiJackCountPorts(jack_client_t* client, XtBool output);
+int
+XtiJackOnGraphOrder(void* arg);
+void
+XtiJackOnPortRegistration(jack_port_id_t port, int registered, void* arg);
+XtFault
+XtiJackWatchPorts(jack_client_t* jc, XtJackPortCache* cache);
+std::vector<std::string> const&
+XtiJackGetPorts(jack_client_t* jc, XtJackPortCache& cache, XtBool output);
 XtFault
-XtiJackCreatePorts(jack_client_t* jc, uint32_t channels, uint64_t mask, unsigned long flag, std::vector<XtJackPort>& result);
+XtiJackCreatePorts(jack_client_t* jc, uint32_t channels, uint64_t mask, unsigned long flag, 
+  std::vector<std::string> const& connectTo, std::vector<XtJackPort>& result);
 
 #endif // XT_ENABLE_JACK
 #endif // XT_JACK_PRIVATE_HPP
\ No newline at end of file
@@ -8,6 +8,9 @@
 XtFault
 JackService::GetFormatFault() const
 { return EINVAL; }
+XtFault
+JackService::GetUnsupportedFault() const
+{ return ENOTSUP; }
 JackService::
 JackService()
 { jack_set_error_function(&XtiJackErrorCallback); }
@@ -25,7 +28,9 @@ JackService::GetCapabilities() const
   auto result = XtServiceCapsTime
     | XtServiceCapsFullDuplex
     | XtServiceCapsChannelMask
-    | XtServiceCapsXRunDetection;
+    | XtServiceCapsXRunDetection
+    | XtServiceCapsFreewheel
+    | XtServiceCapsBufferSize;
   return static_cast<XtServiceCaps>(result);
 }
 
@@ -34,8 +39,24 @@ JackService::OpenDevice(char const* id, XtDevice** device) const
 {  
   auto appId = XtPlatform::instance->_id.c_str();
   XtJackClient jc(jack_client_open(appId, JackNoStartServer, nullptr));
+  XtFault fault;
   if(jc.jc == nullptr) return ESRCH;
   auto result = std::make_unique<JackDevice>(std::move(jc));
+  jack_client_t* client = result->_jc.jc;
+  jack_on_shutdown(client, &JackDevice::ShutdownCallback, result.get());
+  if((fault = XtiJackWatchPorts(client, &result->_ports)) != 0) return fault;
+  if((fault = jack_set_xrun_callback(client, &JackDevice::XRunCallback, result.get())) != 0) return fault;
+  if((fault = jack_set_buffer_size_callback(client, &JackDevice::BufferSizeCallback, result.get())) != 0) return fault;
+  if((fault = jack_set_sample_rate_callback(client, &JackDevice::SampleRateCallback, result.get())) != 0) return fault;
+  if((fault = jack_set_freewheel_callback(client, &JackDevice::FreewheelCallback, result.get())) != 0) return fault;
+  if((fault = jack_set_process_callback(client, &JackDevice::ProcessCallback, result.get())) != 0) return fault;
+  // Port notifications only reach active clients, so activate right away
+  // to keep the port cache valid for format and channel queries. The
+  // process callback has no streams to service until one is opened.
+  result->_nextRate.store(static_cast<int32_t>(jack_get_sample_rate(client)));
+  result->_nextFrames.store(static_cast<int32_t>(jack_get_buffer_size(client)));
+  if((fault = jack_activate(client)) != 0) return fault;
+  result->_reconfigurer = std::thread(&JackDevice::RunReconfigure, result.get());
   *device = result.release();
   return 0;
 }
@@ -8,7 +8,17 @@
 #include <xt/backend/jack/Private.hpp>
 
 #include <jack/jack.h>
+#include <mutex>
+#include <atomic>
+#include <thread>
 #include <vector>
+#include <condition_variable>
+
+struct XtJackBuffers
+{
+  int32_t frames;
+  XtIOBuffers buffers;
+};
 
 struct JackService final:
 public XtService 
@@ -18,16 +28,85 @@ public XtService
   XT_IMPLEMENT_SERVICE(JACK);
 };
 
+struct JackStream;
 struct JackDevice final:
 public XtDevice
 {
+  mutable XtJackPortCache _ports;
+  bool _clockValid;
+  double _clockTime;
+  uint64_t _clockPosition;
+  jack_nframes_t _clockFrames;
+  bool _clockFreewheeled;
+  double _clockTimeOffset;
+  uint64_t _clockPositionOffset;
+  // _lock guards the stream list. _notifying is taken before it by the
+  // reconfigure thread while handlers run and by RemoveStream, so no
+  // stream is destroyed during a notification. It is recursive since a
+  // handler may close a stream on its own device.
+  std::mutex _lock;
+  std::recursive_mutex _notifying;
+  std::mutex _signalLock;
+  std::condition_variable _signal;
+  std::atomic_int _closing;
+  std::atomic_int _nextRate;
+  std::atomic_int _nextFrames;
+  std::atomic_int _reconfigure;
+  std::thread _reconfigurer;
+  std::atomic_int _freewheel;
+  std::atomic_int _readers;
+  std::atomic<std::vector<JackStream*> const*> _streams;
   XtJackClient _jc;
   XT_IMPLEMENT_DEVICE();
   XT_IMPLEMENT_DEVICE_STREAM();
   XT_IMPLEMENT_DEVICE_BASE(JACK);
+  ~JackDevice();
   JackDevice(XtJackClient&& jc);
+
+  void
+  AddStream(JackStream* stream);
+  void
+  RemoveStream(JackStream* stream);
+  void
+  Synchronize();
+  void
+  Signal(std::atomic_int& value, int32_t next);
+  bool
+  HasStream(JackStream* stream);
+  void
+  PublishStreams(std::vector<JackStream*> const* streams);
+  std::vector<std::string> const&
+  GetPorts(XtBool output) const;
+
+  template <class F> void
+  ForEachStream(F f);
+
+  static int 
+  XRunCallback(void* arg);
+  static void
+  ShutdownCallback(void* arg);
+  static int 
+  ProcessCallback(jack_nframes_t frames, void* arg);
+  static int
+  BufferSizeCallback(jack_nframes_t frames, void* arg);
+  static int
+  SampleRateCallback(jack_nframes_t rate, void* arg);
+  static void
+  FreewheelCallback(int starting, void* arg);
+  static void
+  RunReconfigure(JackDevice* device);
 };
 
+// Callbacks only announce themselves as readers and never wait;
+// writers wait for the readers to drain before freeing a list.
+template <class F> inline void
+JackDevice::ForEachStream(F f)
+{
+  _readers.fetch_add(1);
+  for(auto stream: *_streams.load()) f(stream);
+  _readers.fetch_sub(1);
+}
+
 struct JackDeviceList final:
 public XtDeviceList
 {
@@ -37,8 +116,11 @@ public XtDeviceList
 struct JackStream final:
 public XtStream
 {
-  XtJackClient _jc;
+  int32_t _frames;
+  JackDevice* _device;
+  std::atomic_int _rate;
   std::atomic_int _running;
+  std::atomic<XtJackBuffers*> _published;
   std::atomic_int _insideCallback;
   std::vector<XtJackPort> _inputs;
   std::vector<XtJackPort> _outputs;
@@ -46,17 +128,19 @@ public XtStream
   std::vector<void*> _outputChannels;
   std::vector<XtJackConnection> _connections;
 
-  JackStream(XtJackClient&& jc);
+  ~JackStream();
+  JackStream(JackDevice* device);
   XT_IMPLEMENT_STREAM();
   XT_IMPLEMENT_STREAM_BASE();
   XT_IMPLEMENT_STREAM_BASE_SYSTEM(JACK);
+  XtFault SetFreewheel(XtBool freewheel) override final;
+  XtFault SetBufferSize(double bufferSize) override final;
+  XtFault OnBuffer(int32_t index, XtBuffer const* buffer) override final;
 
-  static int 
-  XRunCallback(void* arg);
-  static void
-  ShutdownCallback(void* arg);
-  static int 
-  ProcessCallback(jack_nframes_t frames, void* arg);
+  void
+  ProcessBuffer(XtBuffer const& cycle);
+  bool
+  Reconfigure(int32_t frames, int32_t rate);
 };
 
 #endif // XT_ENABLE_JACK
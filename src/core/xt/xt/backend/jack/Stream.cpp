@@ -1,44 +1,57 @@
 #if XT_ENABLE_JACK
 #include <xt/backend/jack/Shared.hpp>
 #include <xt/backend/jack/Private.hpp>
+#include <xt/shared/Trace.hpp>
+#include <xt/shared/RtCheck.hpp>
 
+#include <memory>
+#include <cstring>
 #include <utility>
 
 JackStream::
-JackStream(XtJackClient&& jc):
-_jc(std::move(jc)) { }
+JackStream(JackDevice* device):
+_device(device), _published(nullptr) { }
+JackStream::
+~JackStream()
+{
+  _device->RemoveStream(this);
+  delete _published.load();
+}
 
 void*
 JackStream::GetHandle() const
-{ return _jc.jc; }
+{ return _device->_jc.jc; }
 XtBool
 JackStream::IsRunning() const
 { return _running.load() != 0; }
 XtFault
+JackStream::SetFreewheel(XtBool freewheel)
+{ return jack_set_freewheel(_device->_jc.jc, freewheel != XtFalse? 1: 0); }
+XtFault
 JackStream::GetLatency(XtLatency* latency) const
 { return 0; }
-XtFault
-JackStream::GetFrames(int32_t* frames) const
-{ *frames = jack_get_buffer_size(_jc.jc); return 0; }
-int JackStream::XRunCallback(void* arg)
-{ static_cast<JackStream*>(arg)->OnXRun(-1); return 0; }
 
-void
-JackStream::ShutdownCallback(void* arg)
+// JACK periods are a power of two. The server reconfigures all clients,
+// the device reconfigure thread then swaps in new buffers.
+XtFault
+JackStream::SetBufferSize(double bufferSize)
 {
-  auto stream = static_cast<JackStream*>(arg);
-  XtiCompareExchange(stream->_running, 1, 0);
-  stream->OnRunning(XtFalse, 0);
+  jack_nframes_t frames = 1;
+  double df = bufferSize / 1000.0 * _rate.load();
+  while(frames < df) frames *= 2;
+  return jack_set_buffer_size(_device->_jc.jc, frames);
 }
+XtFault
+JackStream::GetFrames(int32_t* frames) const
+{ *frames = jack_get_buffer_size(_device->_jc.jc); return 0; }
 
 void
 JackStream::Stop()
-{ 
+{
   // may be stopped from ShutdownCallback
   XtiCompareExchange(_running, 1, 0);
   while(_insideCallback.load() == 1);
   _connections.clear();
-  XT_TRACE_IF(jack_deactivate(_jc.jc) != 0);
   OnRunning(XtFalse, 0);
 }
 
@@ -46,30 +59,28 @@ XtFault
 JackStream::Start()
 {  
   XtFault fault;
+  jack_client_t* jc = _device->_jc.jc;
   std::vector<XtJackConnection> connections;
   auto const& channels = _params.format.channels;
   
   // may be stopped from ShutdownCallback
   _connections.clear();
-  jack_deactivate(_jc.jc);
   XT_ASSERT(XtiCompareExchange(_running, 0, 1));
   auto guard = XtiGuard([this] { XtiCompareExchange(_running, 1, 0); });
-  jack_on_shutdown(_jc.jc, &JackStream::ShutdownCallback, this);
-  if((fault = jack_activate(_jc.jc)) != 0) return fault;
 
   for(int32_t i = 0; i < channels.inputs; i++)
   {
-    char const* src = _inputs[i].connectTo;
+    char const* src = _inputs[i].connectTo.c_str();
     char const* dst = jack_port_name(_inputs[i].port);
-    if((fault = jack_connect(_jc.jc, src, dst)) != 0) return fault;
-    connections.emplace_back(XtJackConnection(_jc.jc, src, dst));
+    if((fault = jack_connect(jc, src, dst)) != 0) return fault;
+    connections.emplace_back(XtJackConnection(jc, src, dst));
   }
   for(int32_t i = 0; i < channels.outputs; i++)
   {
-    char const* dst = _outputs[i].connectTo;
+    char const* dst = _outputs[i].connectTo.c_str();
     char const* src = jack_port_name(_outputs[i].port);
-    if((fault = jack_connect(_jc.jc, src, dst)) != 0) return fault;
-    connections.emplace_back(XtJackConnection(_jc.jc, src, dst));
+    if((fault = jack_connect(jc, src, dst)) != 0) return fault;
+    connections.emplace_back(XtJackConnection(jc, src, dst));
   }  
   _connections = std::move(connections);
   OnRunning(XtTrue, 0);
@@ -77,35 +88,65 @@ JackStream::Start()
   return 0;
 }
 
-int 
-JackStream::ProcessCallback(jack_nframes_t frames, void* arg)
-{    
-  XtBuffer buffer = { 0 };
-  buffer.frames = frames;
-  JackStream* s = static_cast<JackStream*>(arg);
-  buffer.input = s->_inputs.empty()? nullptr: s->_inputChannels.data();
-  buffer.output = s->_outputs.empty()? nullptr: s->_outputChannels.data(); 
-
-  if(s->_running.load() != 1) return 0;
-  if(!XtiCompareExchange(s->_insideCallback, 0, 1)) return 0;
-
-  float period;
-  jack_time_t time, next;
-  jack_nframes_t position;
-  if(jack_get_cycle_times(s->_jc.jc, &position, &time, &next, &period) == 0)
+// Runs on the device reconfigure thread under the device lock. Buffers
+// only ever grow, the previous ones are freed once no process cycle can
+// still use them. Returns whether the application is to be notified.
+// The stream format keeps the rate it was opened with, only running
+// streams are notified of the current one.
+bool
+JackStream::Reconfigure(int32_t frames, int32_t rate)
+{
+  if(frames == _frames && rate == _rate.load()) return false;
+  if(frames > _published.load()->frames)
   {
-    buffer.timeValid = XtTrue;
-    buffer.position = position;
-    buffer.time = time / 1000.0;
+    auto buffers = std::make_unique<XtJackBuffers>();
+    buffers->frames = frames;
+    XtiInitIOBuffers(buffers->buffers, &_params.format, frames);
+    std::unique_ptr<XtJackBuffers> previous(_published.exchange(buffers.release()));
+    _device->Synchronize();
   }
+  _frames = frames;
+  _rate.store(rate);
+  return _running.load() == 1;
+}
 
-  for(int32_t i = 0; i < s->_inputs.size(); i++)
-    s->_inputChannels[i] = jack_port_get_buffer(s->_inputs[i].port, frames);
-  for(int32_t i = 0; i < s->_outputs.size(); i++)
-    s->_outputChannels[i] = jack_port_get_buffer(s->_outputs[i].port, frames);
-  XT_ASSERT(s->OnBuffer(-1, &buffer) == 0);  
-  XT_ASSERT(XtiCompareExchange(s->_insideCallback, 1, 0));
-  return 0;
+XtFault
+JackStream::OnBuffer(int32_t index, XtBuffer const* buffer)
+{
+  XT_RT_SCOPE(true);
+  XT_TRACE_SPAN("OnBuffer");
+  XtOnBufferParams params = { 0 };
+  params.index = index;
+  params.buffer = buffer;
+  params.emulated = _emulated;
+  params.format = &_params.format;
+  params.buffers = &_published.load()->buffers;
+  params.interleaved = _params.stream.interleaved;
+  return XtiOnBuffer(&params, [this](XtBuffer const* converted) { 
+    return OnAppBuffer(converted); });
+}
+
+// Until buffers for a grown period are published the stream outputs
+// silence, which only happens for the first cycles after a change.
+void
+JackStream::ProcessBuffer(XtBuffer const& cycle)
+{    
+  XT_RT_SCOPE(true);
+  XT_TRACE_SPAN("ProcessBuffer");
+  XtBuffer buffer = cycle;
+  jack_nframes_t frames = cycle.frames;
+  buffer.input = _inputs.empty()? nullptr: _inputChannels.data();
+  buffer.output = _outputs.empty()? nullptr: _outputChannels.data(); 
+
+  if(_running.load() != 1) return;
+  if(!XtiCompareExchange(_insideCallback, 0, 1)) return;
+  for(int32_t i = 0; i < _inputs.size(); i++)
+    _inputChannels[i] = jack_port_get_buffer(_inputs[i].port, frames);
+  for(int32_t i = 0; i < _outputs.size(); i++)
+    _outputChannels[i] = jack_port_get_buffer(_outputs[i].port, frames);
+  if(static_cast<int32_t>(frames) <= _published.load()->frames) XT_ASSERT(OnBuffer(-1, &buffer) == 0);
+  else for(auto channel: _outputChannels) std::memset(channel, 0, frames * sizeof(float));
+  XT_ASSERT(XtiCompareExchange(_insideCallback, 1, 0));
 }
 
 #endif // XT_ENABLE_JACK
\ No newline at end of file
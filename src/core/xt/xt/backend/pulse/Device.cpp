@@ -8,8 +8,8 @@
 #include <cmath>
 
 PulseDevice::
-PulseDevice(bool output): 
-_output(output) { }
+PulseDevice(bool output, std::shared_ptr<XtPaConnection> const& connection): 
+_output(output), _connection(connection) { }
 
 void*
 PulseDevice::GetHandle() const
@@ -71,9 +71,7 @@ PulseDevice::SupportsFormat(XtFormat const* format, XtBool* supports) const
 XtFault 
 PulseDevice::OpenBlockingStream(XtBlockingParams const* params, XtBlockingStream** stream)
 {
-  pa_simple* pa;
-  int fault = PA_OK;
-
+  pa_stream_state_t state;
   pa_sample_spec spec;
   spec.rate = params->format.mix.rate;
   auto const& channels = params->format.channels;
@@ -93,17 +91,38 @@ PulseDevice::OpenBlockingStream(XtBlockingParams const* params, XtBlockingStream
     pa_channel_map_init_extend(&map, spec.channels, PA_CHANNEL_MAP_DEFAULT);
   
   auto id = XtPlatform::instance->_id.c_str();
-  auto dir = _output? PA_STREAM_PLAYBACK: PA_STREAM_RECORD;
   double df = params->bufferSize / 1000.0 * params->format.mix.rate;
   int32_t frames = static_cast<int32_t>(std::ceil(df));
   int32_t sampleSize = XtiGetSampleSize(params->format.mix.sample);
   int32_t frameSize = (channels.inputs + channels.outputs) * sampleSize;
-  if((pa = pa_simple_new(nullptr, id, dir, nullptr, id, &spec, &map, nullptr, &fault)) == nullptr) return fault;
+  auto attr = XtiGetPaBufferAttr(_output, static_cast<uint32_t>(frames * frameSize));
+  auto flags = static_cast<pa_stream_flags_t>(PA_STREAM_START_CORKED | PA_STREAM_ADJUST_LATENCY
+    | PA_STREAM_INTERPOLATE_TIMING | PA_STREAM_AUTO_TIMING_UPDATE);
 
   auto result = std::make_unique<PulseStream>();
+  XtPaLock lock(_connection->mainloop);
+  result->_pa.connection = _connection;
+  if((result->_pa.stream = pa_stream_new(_connection->context, id, &spec, &map)) == nullptr)
+    return XtiGetPaContextFault(_connection->context);
+  if((result->_pa.timer = pa_context_rttime_new(_connection->context, PA_USEC_INVALID, &XtiOnPaTimer, _connection->mainloop)) == nullptr)
+    return PA_ERR_INTERNAL;
+  pa_stream_set_state_callback(result->_pa.stream, &XtiOnPaStreamState, _connection->mainloop);
+  if(_output) pa_stream_set_write_callback(result->_pa.stream, &XtiOnPaStreamRequest, _connection->mainloop);
+  else pa_stream_set_read_callback(result->_pa.stream, &XtiOnPaStreamRequest, _connection->mainloop);
+  if(( _output && pa_stream_connect_playback(result->_pa.stream, nullptr, &attr, flags, nullptr, nullptr) < 0) ||
+     (!_output && pa_stream_connect_record(result->_pa.stream, nullptr, &attr, flags) < 0))
+    return XtiGetPaContextFault(_connection->context);
+  while((state = pa_stream_get_state(result->_pa.stream)) != PA_STREAM_READY)
+  {
+    if(!PA_STREAM_IS_GOOD(state)) return XtiGetPaContextFault(_connection->context);
+    pa_threaded_mainloop_wait(_connection->mainloop);
+  }
+
+  frames = XtiGetPaBufferFrames(result->_pa.stream, _output, frameSize, frames);
+  result->_processed = 0;
   result->_frames = frames;
   result->_output = _output;
-  result->_pa = XtPaSimple(pa);
+  result->_frameSize = frameSize;
   result->_audio = std::vector<uint8_t>(static_cast<size_t>(frames * frameSize), 0);
   *stream = result.release();
   return PA_OK;
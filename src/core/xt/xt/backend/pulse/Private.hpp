@@ -1,8 +1,8 @@
 #ifndef XT_PULSE_PRIVATE_HPP
 #define XT_PULSE_PRIVATE_HPP
 #if XT_ENABLE_PULSE
-#include <pulse/simple.h>
 #include <pulse/pulseaudio.h>
+#include <memory>
 
 inline int32_t const
 XtiPaMinRate = 1;
@@ -19,6 +19,8 @@ inline double const
 XtiPaMaxBufferSize = 2000.0;
 inline double const
 XtiPaDefaultBufferSize = 80.0;
+inline int32_t const
+XtiPaRequestsPerBuffer = 2;
 
 inline XtFault const
 XT_PA_ERR_FORMAT = PA_ERR_MAX + 1;
@@ -29,21 +31,60 @@ pa_sample_format
 XtiSampleToPulse(XtSample sample);
 XtCause
 XtiGetPulseFaultCause(XtFault fault);
-int
-XtiCreatePulseDefaultClient(XtBool output, pa_simple** pa);
 
-struct XtPaSimple
+struct XtPaLock
+{
+  pa_threaded_mainloop* const mainloop;
+  XtPaLock(XtPaLock const&) = delete;
+  XtPaLock& operator=(XtPaLock const&) = delete;
+
+  ~XtPaLock() { pa_threaded_mainloop_unlock(mainloop); }
+  XtPaLock(pa_threaded_mainloop* mainloop): mainloop(mainloop) { pa_threaded_mainloop_lock(mainloop); }
+};
+
+struct XtPaConnection
 {
-  pa_simple* pa;
-  XtPaSimple(XtPaSimple const&) = delete;
-  XtPaSimple& operator=(XtPaSimple const&) = delete;
-
-  XtPaSimple(): pa(nullptr) {}
-  XtPaSimple(pa_simple* pa): pa(pa) { }
-  ~XtPaSimple() { if(pa != nullptr) pa_simple_free(pa); }
-  XtPaSimple(XtPaSimple&& rhs): pa(rhs.pa) { rhs.pa = nullptr; }
-  XtPaSimple& operator=(XtPaSimple&& rhs) { pa = rhs.pa; rhs.pa = nullptr; return *this; }
+  pa_context* context;
+  pa_threaded_mainloop* mainloop;
+  XtPaConnection(XtPaConnection const&) = delete;
+  XtPaConnection& operator=(XtPaConnection const&) = delete;
+
+  ~XtPaConnection();
+  XtPaConnection(): context(nullptr), mainloop(nullptr) { }
 };
 
+struct XtPaStream
+{
+  pa_stream* stream;
+  pa_time_event* timer;
+  std::shared_ptr<XtPaConnection> connection;
+  XtPaStream(XtPaStream const&) = delete;
+  XtPaStream& operator=(XtPaStream const&) = delete;
+
+  ~XtPaStream();
+  XtPaStream(): stream(nullptr), timer(nullptr), connection() { }
+};
+
+XtFault
+XtiGetPaContextFault(pa_context* context);
+pa_buffer_attr
+XtiGetPaBufferAttr(bool output, uint32_t bytes);
+int32_t
+XtiGetPaBufferFrames(pa_stream* stream, bool output, int32_t frameSize, int32_t requested);
+void
+XtiOnPaContextState(pa_context* context, void* user);
+void
+XtiOnPaStreamState(pa_stream* stream, void* user);
+void
+XtiOnPaStreamRequest(pa_stream* stream, size_t bytes, void* user);
+void
+XtiOnPaStreamSuccess(pa_stream* stream, int success, void* user);
+void
+XtiOnPaTimer(pa_mainloop_api* api, pa_time_event* event, timeval const* tv, void* user);
+XtFault
+XtiPaWaitOperation(XtPaConnection const& connection, pa_operation* operation);
+XtFault
+XtiPaOpenConnection(std::shared_ptr<XtPaConnection>* connection);
+
 #endif // XT_ENABLE_PULSE
 #endif // XT_PULSE_PRIVATE_HPP
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <xt/backend/pulse/Shared.hpp>
 
 #include <pulse/pulseaudio.h>
+#include <utility>
 
 std::unique_ptr<XtService>
 XtiCreatePulseService()
@@ -51,20 +52,109 @@ XtiGetPulseError(XtFault fault)
   return result;
 }
 
-int
-XtiCreatePulseDefaultClient(XtBool output, pa_simple** pa)
+XtFault
+XtiGetPaContextFault(pa_context* context)
 {
-  int error = 0;
-  pa_sample_spec spec;
-  spec.rate = XtiPaDefaultRate;
-  spec.channels = XtiPaDefaultChannels;
-  spec.format = XtiSampleToPulse(XtiPaDefaultSample);
+  int fault = pa_context_errno(context);
+  return fault != PA_OK? fault: PA_ERR_CONNECTIONTERMINATED;
+}
+
+pa_buffer_attr
+XtiGetPaBufferAttr(bool output, uint32_t bytes)
+{
+  pa_buffer_attr result;
+  uint32_t const unset = static_cast<uint32_t>(-1);
+  result.maxlength = unset;
+  result.tlength = output? bytes: unset;
+  result.prebuf = output? bytes: unset;
+  result.minreq = output? bytes / XtiPaRequestsPerBuffer: unset;
+  result.fragsize = output? unset: bytes;
+  return result;
+}
+
+// The server may adjust the requested attributes, so the buffer size
+// follows what was granted: tlength for playback, fragsize for record.
+// Call with the mainloop locked.
+int32_t
+XtiGetPaBufferFrames(pa_stream* stream, bool output, int32_t frameSize, int32_t requested)
+{
+  pa_buffer_attr const* attr = pa_stream_get_buffer_attr(stream);
+  if(attr == nullptr) return requested;
+  uint32_t bytes = output? attr->tlength: attr->fragsize;
+  int32_t frames = static_cast<int32_t>(bytes / static_cast<uint32_t>(frameSize));
+  return frames > 0? frames: requested;
+}
+
+void
+XtiOnPaContextState(pa_context* context, void* user)
+{ pa_threaded_mainloop_signal(static_cast<pa_threaded_mainloop*>(user), 0); }
+void
+XtiOnPaStreamState(pa_stream* stream, void* user)
+{ pa_threaded_mainloop_signal(static_cast<pa_threaded_mainloop*>(user), 0); }
+void
+XtiOnPaStreamRequest(pa_stream* stream, size_t bytes, void* user)
+{ pa_threaded_mainloop_signal(static_cast<pa_threaded_mainloop*>(user), 0); }
+void
+XtiOnPaStreamSuccess(pa_stream* stream, int success, void* user)
+{ pa_threaded_mainloop_signal(static_cast<pa_threaded_mainloop*>(user), 0); }
+void
+XtiOnPaTimer(pa_mainloop_api* api, pa_time_event* event, timeval const* tv, void* user)
+{ pa_threaded_mainloop_signal(static_cast<pa_threaded_mainloop*>(user), 0); }
+
+XtPaConnection::
+~XtPaConnection()
+{
+  if(mainloop != nullptr) pa_threaded_mainloop_stop(mainloop);
+  if(context != nullptr) pa_context_disconnect(context);
+  if(context != nullptr) pa_context_unref(context);
+  if(mainloop != nullptr) pa_threaded_mainloop_free(mainloop);
+}
+
+XtPaStream::
+~XtPaStream()
+{
+  if(stream == nullptr && timer == nullptr) return;
+  XtPaLock lock(connection->mainloop);
+  if(timer != nullptr) pa_threaded_mainloop_get_api(connection->mainloop)->time_free(timer);
+  if(stream == nullptr) return;
+  pa_stream_set_state_callback(stream, nullptr, nullptr);
+  pa_stream_set_read_callback(stream, nullptr, nullptr);
+  pa_stream_set_write_callback(stream, nullptr, nullptr);
+  pa_stream_disconnect(stream);
+  pa_stream_unref(stream);
+}
+
+XtFault
+XtiPaWaitOperation(XtPaConnection const& connection, pa_operation* operation)
+{
+  if(operation == nullptr) return XtiGetPaContextFault(connection.context);
+  while(pa_operation_get_state(operation) == PA_OPERATION_RUNNING)
+    pa_threaded_mainloop_wait(connection.mainloop);
+  pa_operation_unref(operation);
+  return PA_OK;
+}
+
+XtFault
+XtiPaOpenConnection(std::shared_ptr<XtPaConnection>* connection)
+{
+  pa_context_state_t state;
+  auto result = std::make_shared<XtPaConnection>();
   char const* id = XtPlatform::instance->_id.c_str();
-  auto dir = output? PA_STREAM_PLAYBACK: PA_STREAM_RECORD;
-  *pa = pa_simple_new(nullptr, id, dir, nullptr, id, &spec, nullptr, nullptr, &error);
-  if(error == 0) return 0;
-  if(*pa != nullptr) pa_simple_free(*pa);
-  return error;
+  if((result->mainloop = pa_threaded_mainloop_new()) == nullptr) return PA_ERR_INTERNAL;
+  auto api = pa_threaded_mainloop_get_api(result->mainloop);
+  if((result->context = pa_context_new(api, id)) == nullptr) return PA_ERR_INTERNAL;
+  pa_context_set_state_callback(result->context, &XtiOnPaContextState, result->mainloop);
+  if(pa_context_connect(result->context, nullptr, PA_CONTEXT_NOFLAGS, nullptr) < 0)
+    return XtiGetPaContextFault(result->context);
+  if(pa_threaded_mainloop_start(result->mainloop) < 0) return PA_ERR_INTERNAL;
+  XtPaLock lock(result->mainloop);
+  while((state = pa_context_get_state(result->context)) != PA_CONTEXT_READY)
+  {
+    if(!PA_CONTEXT_IS_GOOD(state)) return XtiGetPaContextFault(result->context);
+    pa_threaded_mainloop_wait(result->mainloop);
+  }
+  *connection = std::move(result);
+  return PA_OK;
 }
 
 #endif // XT_ENABLE_PULSE
\ No newline at end of file
@@ -6,11 +6,19 @@
 XtFault
 PulseService::GetFormatFault() const
 { return XT_PA_ERR_FORMAT; }
+XtFault
+PulseService::GetUnsupportedFault() const
+{ return PA_ERR_NOTSUPPORTED; }
 
 XtServiceCaps 
 PulseService::GetCapabilities() const
 { 
-  auto result = XtServiceCapsAggregation | XtServiceCapsChannelMask;
+  auto result = XtServiceCapsTime
+  | XtServiceCapsLatency
+  | XtServiceCapsAggregation 
+  | XtServiceCapsBufferSize
+  | XtServiceCapsPause
+  | XtServiceCapsChannelMask;
   return static_cast<XtServiceCaps>(result); 
 }
 
@@ -23,14 +31,33 @@ PulseService::OpenDeviceList(XtEnumFlags flags, XtDeviceList** list) const
   return PA_OK; 
 }
 
+// Connects on first use, and again once the context has failed or
+// terminated (e.g. the server restarted). Devices and streams keep the
+// connection they were opened on, the old one goes away with them.
+XtFault
+PulseService::Connect(std::shared_ptr<XtPaConnection>* connection) const
+{
+  XtFault fault;
+  bool good = false;
+  std::lock_guard guard(_lock);
+  if(_connection)
+  {
+    XtPaLock lock(_connection->mainloop);
+    good = PA_CONTEXT_IS_GOOD(pa_context_get_state(_connection->context));
+  }
+  if(!good && (fault = XtiPaOpenConnection(&_connection)) != PA_OK) return fault;
+  *connection = _connection;
+  return PA_OK;
+}
+
 XtFault
 PulseService::OpenDevice(char const* id, XtDevice** device) const
 {
   XtFault fault;
-  XtPaSimple pa;
+  std::shared_ptr<XtPaConnection> connection;
   XtBool output = strcmp(id, "0");
-  if((fault = XtiCreatePulseDefaultClient(output, &pa.pa)) != PA_OK) return fault;
-  *device = new PulseDevice(output);
+  if((fault = Connect(&connection)) != PA_OK) return fault;
+  *device = new PulseDevice(output, connection);
   return PA_OK;
 }
 
@@ -9,14 +9,18 @@
 #include <xt/private/DeviceList.hpp>
 #include <xt/backend/pulse/Private.hpp>
 
-#include <pulse/simple.h>
 #include <pulse/pulseaudio.h>
 #include <cstdint>
+#include <mutex>
+#include <memory>
 #include <vector>
 
 struct PulseService final: 
 public XtService 
 {
+  mutable std::mutex _lock;
+  mutable std::shared_ptr<XtPaConnection> _connection;
+  XtFault Connect(std::shared_ptr<XtPaConnection>* connection) const;
   XT_IMPLEMENT_SERVICE(Pulse);
 };
 
@@ -24,21 +28,27 @@ struct PulseDevice final:
 public XtBlockingDevice
 {
   bool const _output;
+  std::shared_ptr<XtPaConnection> const _connection;
   XT_IMPLEMENT_DEVICE();
   XT_IMPLEMENT_DEVICE_BLOCKING();
   XT_IMPLEMENT_DEVICE_BASE(Pulse);
-  PulseDevice(bool output);
+  PulseDevice(bool output, std::shared_ptr<XtPaConnection> const& connection);
 };
 
 struct PulseStream final:
 public XtBlockingStream 
 {
   bool _output;
-  XtPaSimple _pa;
+  XtPaStream _pa;
   int32_t _frames;
+  int32_t _frameSize;
+  uint64_t _processed;
   std::vector<uint8_t> _audio;
   
   PulseStream() = default;
+  XtFault SetBufferSize(double bufferSize) override final;
+  XtFault PauseSlaveBuffer(XtBool pause) override final;
+  void WakeMasterBuffer() override final;
   XT_IMPLEMENT_STREAM_BASE();
   XT_IMPLEMENT_BLOCKING_STREAM();
   XT_IMPLEMENT_STREAM_BASE_SYSTEM(Pulse);
@@ -2,49 +2,176 @@
 #include <xt/backend/pulse/Shared.hpp>
 
 #include <pulse/pulseaudio.h>
+#include <cmath>
+#include <algorithm>
 #include <utility>
 
-void
-PulseStream::StopSlaveBuffer() { }
 void
 PulseStream::StopMasterBuffer() { }
-
 void*
 PulseStream::GetHandle() const
-{ return _pa.pa; }
-XtFault
-PulseStream::StartSlaveBuffer()
-{ return PA_OK; }
+{ return _pa.stream; }
 XtFault
 PulseStream::StartMasterBuffer()
  { return PA_OK; }
 XtFault
+PulseStream::GetFrames(int32_t* frames) const
+{ *frames = _frames; return PA_OK; }
+XtFault
 PulseStream::PrefillOutputBuffer() 
-{ return PA_OK; }
+{ return _output? ProcessBuffer(): PA_OK; }
+
+void
+PulseStream::StopSlaveBuffer()
+{
+  auto const& c = *_pa.connection;
+  XtPaLock lock(c.mainloop);
+  XT_TRACE_IF(XtiPaWaitOperation(c, pa_stream_cork(_pa.stream, 1, &XtiOnPaStreamSuccess, c.mainloop)) != PA_OK);
+  XT_TRACE_IF(XtiPaWaitOperation(c, pa_stream_flush(_pa.stream, &XtiOnPaStreamSuccess, c.mainloop)) != PA_OK);
+  _processed = 0;
+}
+
 XtFault
-PulseStream::BlockMasterBuffer(XtBool* ready) 
-{ *ready = XtTrue; return PA_OK; }
+PulseStream::StartSlaveBuffer()
+{
+  auto const& c = *_pa.connection;
+  XtPaLock lock(c.mainloop);
+  return XtiPaWaitOperation(c, pa_stream_cork(_pa.stream, 0, &XtiOnPaStreamSuccess, c.mainloop));
+}
+
+// Corks without flushing, queued audio plays on after resuming.
 XtFault
-PulseStream::GetFrames(int32_t* frames) const
-{ *frames = _frames; return PA_OK; }
+PulseStream::PauseSlaveBuffer(XtBool pause)
+{
+  auto const& c = *_pa.connection;
+  XtPaLock lock(c.mainloop);
+  return XtiPaWaitOperation(c, pa_stream_cork(_pa.stream, pause? 1: 0, &XtiOnPaStreamSuccess, c.mainloop));
+}
+
+// The stream stays connected, the server applies the new attributes
+// and the buffer is sized from what it actually granted.
+XtFault
+PulseStream::SetBufferSize(double bufferSize)
+{
+  XtFault fault;
+  auto const& c = *_pa.connection;
+  double df = bufferSize / 1000.0 * _params.format.mix.rate;
+  int32_t frames = static_cast<int32_t>(std::ceil(df));
+  auto attr = XtiGetPaBufferAttr(_output, static_cast<uint32_t>(frames * _frameSize));
+  {
+    XtPaLock lock(c.mainloop);
+    auto operation = pa_stream_set_buffer_attr(_pa.stream, &attr, &XtiOnPaStreamSuccess, c.mainloop);
+    if((fault = XtiPaWaitOperation(c, operation)) != PA_OK) return fault;
+    frames = XtiGetPaBufferFrames(_pa.stream, _output, _frameSize, frames);
+  }
+  _frames = frames;
+  _audio.assign(static_cast<size_t>(frames * _frameSize), 0);
+  return PA_OK;
+}
+
 XtFault
 PulseStream::GetLatency(XtLatency* latency) const
-{ return PA_OK; }
+{
+  int err;
+  int negative;
+  pa_usec_t usec;
+  auto const& c = *_pa.connection;
+  XtPaLock lock(c.mainloop);
+  if((err = pa_stream_get_latency(_pa.stream, &usec, &negative)) == -PA_ERR_NODATA) return PA_OK;
+  if(err < 0) return -err;
+  double ms = negative? 0.0: usec / 1000.0;
+  if(_output) latency->output = ms;
+  else latency->input = ms;
+  return PA_OK;
+}
+
+void
+PulseStream::WakeMasterBuffer()
+{
+  auto const& c = *_pa.connection;
+  XtPaLock lock(c.mainloop);
+  pa_threaded_mainloop_signal(c.mainloop, 0);
+}
+
+XtFault
+PulseStream::BlockMasterBuffer(XtBool* ready) 
+{
+  size_t size;
+  auto const& c = *_pa.connection;
+  XtPaLock lock(c.mainloop);
+  if(!PA_STREAM_IS_GOOD(pa_stream_get_state(_pa.stream))) return XtiGetPaContextFault(c.context);
+  size = _output? pa_stream_writable_size(_pa.stream): pa_stream_readable_size(_pa.stream);
+  if(size == static_cast<size_t>(-1)) return XtiGetPaContextFault(c.context);
+  *ready = size > 0;
+  if(*ready) return PA_OK;
+  // Wakes up after at most one period even if the server goes quiet,
+  // so the runner gets to look at pending stop and pause requests.
+  auto period = static_cast<pa_usec_t>(_frames) * PA_USEC_PER_SEC / _params.format.mix.rate;
+  pa_context_rttime_restart(c.context, _pa.timer, pa_rtclock_now() + period);
+  pa_threaded_mainloop_wait(c.mainloop);
+  return PA_OK;
+}
 
 XtFault 
 PulseStream::ProcessBuffer()
-{  
-  int fault;
+{
+  size_t size;
+  pa_usec_t usec;
+  XtFault fault = PA_OK;
+  void* output = nullptr;
+  void const* input = nullptr;
   XtBuffer buffer = { 0 };
-  void* input = _output? nullptr: _audio.data();
-  void* output = !_output? nullptr: _audio.data();  
-  if(!_output && pa_simple_read(_pa.pa, input, _audio.size(), &fault) < 0) return fault;
-  buffer.input = input;
-  buffer.output = output;
-  buffer.frames = _frames;
-  if((fault = OnBuffer(_params.index, &buffer)) != 0) return fault;
-  if(_output && pa_simple_write(_pa.pa, output, _audio.size(), &fault) < 0) return fault;
-  return PA_OK;
+  auto const& c = *_pa.connection;
+  size_t max = static_cast<size_t>(_frames * _frameSize);
+
+  {
+    XtPaLock lock(c.mainloop);
+    if(pa_stream_get_time(_pa.stream, &usec) == 0)
+    {
+      buffer.timeValid = XtTrue;
+      buffer.time = usec / 1000.0;
+    }
+    if(_output)
+    {
+      size = pa_stream_writable_size(_pa.stream);
+      if(size == static_cast<size_t>(-1)) return XtiGetPaContextFault(c.context);
+      if((size = std::min(size, max) / _frameSize * _frameSize) == 0) return PA_OK;
+      if(pa_stream_begin_write(_pa.stream, &output, &size) < 0) return XtiGetPaContextFault(c.context);
+    } else
+    {
+      if(pa_stream_peek(_pa.stream, &input, &size) < 0) return XtiGetPaContextFault(c.context);
+      if(size == 0) return PA_OK;
+    }
+  }
+
+  if(_output)
+  {
+    buffer.output = output;
+    buffer.position = _processed;
+    buffer.frames = static_cast<int32_t>(size / _frameSize);
+    fault = OnBuffer(_params.index, &buffer);
+    _processed += buffer.frames;
+    XtPaLock lock(c.mainloop);
+    if(fault != 0) return pa_stream_cancel_write(_pa.stream), fault;
+    auto bytes = static_cast<size_t>(buffer.frames * _frameSize);
+    if(pa_stream_write(_pa.stream, output, bytes, nullptr, 0, PA_SEEK_RELATIVE) < 0) return XtiGetPaContextFault(c.context);
+    return PA_OK;
+  }
+
+  for(size_t offset = 0; offset < size; offset += max)
+  {
+    auto bytes = std::min(size - offset, max);
+    auto data = static_cast<uint8_t const*>(input);
+    buffer.position = _processed;
+    buffer.frames = static_cast<int32_t>(bytes / _frameSize);
+    buffer.input = data != nullptr? data + offset: _audio.data();
+    if((fault = OnBuffer(_params.index, &buffer)) != 0) break;
+    buffer.time += buffer.frames * 1000.0 / _params.format.mix.rate;
+    _processed += buffer.frames;
+  }
+  XtPaLock lock(c.mainloop);
+  if(pa_stream_drop(_pa.stream) < 0) return XtiGetPaContextFault(c.context);
+  return fault;
 }
 
 #endif // XT_ENABLE_PULSE
\ No newline at end of file
@@ -9,6 +9,9 @@
 XtFault
 WasapiService::GetFormatFault() const
 { return AUDCLNT_E_UNSUPPORTED_FORMAT; }
+XtFault
+WasapiService::GetUnsupportedFault() const
+{ return E_NOTIMPL; }
 
 XtServiceCaps
 WasapiService::GetCapabilities() const
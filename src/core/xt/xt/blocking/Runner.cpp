@@ -1,7 +1,10 @@
 #include <xt/shared/Shared.hpp>
 #include <xt/private/Platform.hpp>
+#include <xt/shared/Trace.hpp>
+#include <xt/shared/RtCheck.hpp>
 #include <xt/blocking/Runner.hpp>
 #include <thread>
+#include <utility>
 
 XtBlockingRunner::
 ~XtBlockingRunner() 
@@ -9,6 +12,12 @@ XtBlockingRunner::
 void
 XtBlockingRunner::Stop()
 { SendControl(State::Stopping); }
+void
+XtBlockingRunner::Rewind()
+{ _stream->Rewind(); }
+XtFault
+XtBlockingRunner::SetFreewheel(XtBool freewheel)
+{ return _stream->SetFreewheel(freewheel); }
 XtSystem
 XtBlockingRunner::GetSystem() const
 { return _stream->GetSystem(); }
@@ -17,7 +26,11 @@ XtBlockingRunner::GetHandle() const
 { return _stream->GetHandle(); }
 XtFault
 XtBlockingRunner::Start() 
-{ SendControl(State::Starting); return 0; }
+{
+  if(_state.load() == State::Paused) return SetPaused(XtFalse);
+  SendControl(State::Starting); 
+  return 0; 
+}
 XtBool
 XtBlockingRunner::IsRunning() const
 { return _state.load() == State::Started; }
@@ -30,8 +43,8 @@ XtBlockingRunner::GetLatency(XtLatency* latency) const
 
 XtBlockingRunner::
 XtBlockingRunner(XtBlockingStream* stream):
-_received(false), _lock(), _state(State::Stopped), 
-_control(), _respond(), _stream(stream)
+_received(false), _bufferSize(0.0), _settled(State::Stopped), _controlFault(0),
+_lock(), _state(State::Stopped), _control(), _respond(), _stream(stream)
 {
   stream->_runner = this;
   std::thread t(RunBlockingStream, this);
@@ -39,17 +52,93 @@ _control(), _respond(), _stream(stream)
 }
 
 void
-XtBlockingRunner::ReceiveControl(State state, XtFault fault)
+XtBlockingRunner::Respond(State state)
 {
   std::unique_lock guard(_lock);
   _state = state;
+  _settled = state;
   _received = true;
   guard.unlock();
   _respond.notify_one();  
+}
+
+void
+XtBlockingRunner::ReceiveControl(State state, XtFault fault)
+{
+  Respond(state);
   if(state == State::Started) OnRunning(XtTrue, 0);
   if(state == State::Stopped) OnRunning(XtFalse, fault);
 }   
 
+// Pausing keeps the device prepared and the stream thread waiting on
+// the control signal, so resuming costs a single handshake instead of
+// a full stop/prefill/start cycle. No running-state notifications are
+// raised; only a failure to pause or resume reports a stop.
+XtFault
+XtBlockingRunner::SetPaused(XtBool paused)
+{
+  auto state = _state.load();
+  if(paused && state != State::Started) return 0;
+  if(!paused && state != State::Paused) return 0;
+  _controlFault = 0;
+  SendControl(paused? State::Pausing: State::Resuming);
+  return _controlFault;
+}
+
+void
+XtBlockingRunner::Pause(XtBool pause)
+{
+  XtFault fault;
+  if((fault = _stream->PauseBuffer(pause)) == 0)
+    return Respond(pause? State::Paused: State::Started);
+  _controlFault = fault;
+  _stream->StopBuffer();
+  ReceiveControl(State::Stopped, fault);
+}
+
+// Handled by the stream thread in between buffers, so the backend never
+// renegotiates while processing. A running stream is restarted without 
+// running-state notifications; only a failed restart reports a stop.
+// A paused stream is resized from scratch and stays paused.
+XtFault
+XtBlockingRunner::SetBufferSize(double bufferSize)
+{
+  _controlFault = 0;
+  _bufferSize = bufferSize;
+  SendControl(State::Resizing);
+  return _controlFault;
+}
+
+// When renegotiation or the restart fails, the device buffer is stopped
+// before the stop is reported, so no half-restarted device keeps running.
+void
+XtBlockingRunner::Resize()
+{
+  XtFault fault;
+  int32_t frames;
+  int32_t previous;
+  XtIOBuffers buffers;
+  State state = _settled;
+  if(state != State::Stopped) _stream->StopBuffer();
+  if((fault = _stream->GetFrames(&previous)) == 0 &&
+     (fault = _stream->SetBufferSize(_bufferSize)) == 0 &&
+     (fault = _stream->GetFrames(&frames)) == 0 && frames != previous)
+  {
+    XtiInitIOBuffers(buffers, &_params.format, frames);
+    std::swap(_buffers, buffers);
+    OnReconfigure(frames, _params.format.mix.rate);
+  }
+  _controlFault = fault;
+  if(state == State::Stopped) return Respond(State::Stopped);
+  if(fault == 0 && state == State::Paused && (fault = _stream->PauseBuffer(XtTrue)) == 0)
+    return Respond(State::Paused);
+  if(fault == 0 && state == State::Started && (fault = _stream->PrefillOutputBuffer()) == 0 && (fault = _stream->StartBuffer()) == 0)
+    return Respond(State::Started);
+  _controlFault = fault;
+  _stream->StopBuffer();
+  ReceiveControl(State::Stopped, fault);
+}
+
 void
 XtBlockingRunner::SendControl(State from)
 {
@@ -57,6 +146,7 @@ XtBlockingRunner::SendControl(State from)
   _state = from;
   _received = false;
   _control.notify_one();
+  _stream->WakeMasterBuffer();
   auto pred = [this] { return _received; };
   auto timeout = std::chrono::milliseconds(WaitTimeoutMs);
   XT_ASSERT(_respond.wait_for(guard, timeout, pred));
@@ -73,12 +163,9 @@ XtBlockingRunner::RunBlockingStream(XtBlockingRunner* runner)
   XtPlatform::BeginThread();
   XtPlatform::RaiseThreadPriority(&threadPolicy, &prevThreadPrio);
 
-  while((state = runner->_state.load()) != State::Closed)
+  while((state = runner->_state.load()) != State::Closing)
     switch(state)
     {
-    case State::Closing:
-      runner->ReceiveControl(State::Closed, 0);
-      break;
     case State::Stopping:
       runner->_stream->StopBuffer();
       runner->ReceiveControl(State::Stopped, 0);
@@ -86,10 +173,17 @@ XtBlockingRunner::RunBlockingStream(XtBlockingRunner* runner)
     case State::Started:   
       fault = 0;   
       ready = XtFalse;
-      while(!ready && fault == 0)
+      while(!ready && fault == 0 && runner->_state.load() == State::Started)
+      {
+        XT_TRACE_SPAN("BlockMasterBuffer");
         fault = runner->_stream->BlockMasterBuffer(&ready);
+      }
       if(ready && fault == 0)
+      {
+        XT_RT_SCOPE(true);
+        XT_TRACE_SPAN("ProcessBuffer");
         fault = runner->_stream->ProcessBuffer();
+      }
       if(fault != 0)
       {
         runner->_stream->StopBuffer();
@@ -103,9 +197,19 @@ XtBlockingRunner::RunBlockingStream(XtBlockingRunner* runner)
       else
         runner->ReceiveControl(State::Started, 0);
       break;
+    case State::Resizing:
+      runner->Resize();
+      break;
+    case State::Pausing:
+      runner->Pause(XtTrue);
+      break;
+    case State::Resuming:
+      runner->Pause(XtFalse);
+      break;
+    case State::Paused:
     case State::Stopped:
       {
-      auto pred = [runner] { return runner->_state != State::Stopped; };
+      auto pred = [runner, state] { return runner->_state != state; };
       std::unique_lock guard(runner->_lock);
       runner->_control.wait(guard, pred);
       break;
@@ -116,4 +220,11 @@ XtBlockingRunner::RunBlockingStream(XtBlockingRunner* runner)
     }  
   XtPlatform::RevertThreadPriority(threadPolicy, prevThreadPrio);
   XtPlatform::EndThread();
+
+  // The runner is destroyed as soon as the lock is released, so signal
+  // while holding it and do not touch the runner afterwards.
+  std::unique_lock guard(runner->_lock);
+  runner->_state = State::Closed;
+  runner->_received = true;
+  runner->_respond.notify_one();
 }
\ No newline at end of file
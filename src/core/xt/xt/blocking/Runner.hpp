@@ -17,10 +17,20 @@ public XtStream
   enum class State 
   { 
     Stopped, Starting, Started,
-    Stopping, Closing, Closed 
+    Stopping, Closing, Closed,
+    Resizing, Pausing, Paused,
+    Resuming
   };
 
+  // Resize restores the state it started from (running, paused or
+  // stopped), as last settled by the stream thread itself, so a fault
+  // that stopped the stream just before the request is not undone.
+  // Pause, resume and resize all hand their result back to the main
+  // thread through the shared control fault.
   bool _received;
+  double _bufferSize;
+  State _settled;
+  XtFault _controlFault;
   std::mutex _lock;
   std::atomic<State> _state;
   std::condition_variable _control;
@@ -30,10 +40,17 @@ public XtStream
 
   XT_IMPLEMENT_STREAM();
   XT_IMPLEMENT_STREAM_BASE();
+  void Rewind() override final;
+  XtFault SetFreewheel(XtBool freewheel) override final;
+  XtFault SetPaused(XtBool paused) override final;
+  XtFault SetBufferSize(double bufferSize) override;
   XtSystem GetSystem() const override final;
   ~XtBlockingRunner();
   XtBlockingRunner(XtBlockingStream* stream);
   
+  void Resize();
+  void Pause(XtBool pause);
+  void Respond(State state);
   void SendControl(State from);
   void ReceiveControl(State state, XtFault fault);
   static void RunBlockingStream(XtBlockingRunner* runner);
@@ -24,4 +24,13 @@ XtBlockingStream::StartBuffer()
   if((fault = StartSlaveBuffer()) != 0) return fault;
   masterGuard.Commit();
   return 0;
+}
+
+// Restarting the master buffer on resume resynchronizes clocked streams.
+XtFault
+XtBlockingStream::PauseBuffer(XtBool pause)
+{
+  XtFault fault;
+  if((fault = PauseSlaveBuffer(pause)) != 0) return fault;
+  return pause? 0: StartMasterBuffer();
 }
\ No newline at end of file
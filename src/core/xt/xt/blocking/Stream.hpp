@@ -30,9 +30,14 @@ public XtStreamBase
   virtual XtFault StartMasterBuffer() = 0;  
   virtual XtFault PrefillOutputBuffer() = 0;
   virtual XtFault BlockMasterBuffer(XtBool* ready) = 0;
+  virtual XtFault PauseSlaveBuffer(XtBool pause) { return 0; }
+  // Called on the main thread after a control request is posted. Streams
+  // which may block for longer than a period cut BlockMasterBuffer short.
+  virtual void WakeMasterBuffer() { }
 
   void StopBuffer();
   XtFault StartBuffer();
+  XtFault PauseBuffer(XtBool pause);
   void OnXRun(int32_t index) const override final;
   XtFault OnBuffer(int32_t index, XtBuffer const* buffer) override final;
 };
@@ -1,3 +1,5 @@
+#include <xt/shared/Trace.hpp>
+#include <xt/shared/RtCheck.hpp>
 #include <xt/shared/Shared.hpp>
 #include <xt/private/Stream.hpp>
 
@@ -11,6 +13,8 @@ XtStream::OnXRun(int32_t index) const
 XtFault
 XtStream::OnBuffer(int32_t index, XtBuffer const* buffer)
 {
+  XT_RT_SCOPE(true);
+  XT_TRACE_SPAN("OnBuffer");
   XtOnBufferParams params = { 0 };
   params.index = index;
   params.buffer = buffer;
@@ -19,12 +23,39 @@ XtStream::OnBuffer(int32_t index, XtBuffer const* buffer)
   params.format = &_params.format;
   params.interleaved = _params.stream.interleaved;
   return XtiOnBuffer(&params, [this](XtBuffer const* converted) { 
-    return _params.stream.onBuffer(this, converted, _user); });
+    return OnAppBuffer(converted); });
+}
+
+XtFault
+XtStream::OnAppBuffer(XtBuffer const* buffer)
+{
+  XtFault fault;
+  _recorder.Write(buffer, false);
+  if(_params.stream.onBuffer == nullptr) _queue.OnBuffer(buffer);
+  else
+  {
+    XT_RT_SCOPE(false);
+    XT_TRACE_SPAN("UserCallback");
+    auto start = _watchdog.Begin();
+    fault = _params.stream.onBuffer(this, buffer, _user);
+    _watchdog.End(start, buffer->frames, _params.format.mix.rate);
+    if(fault != 0) return fault;
+  }
+  _recorder.Write(buffer, true);
+  return 0;
+}
+
+void
+XtStream::OnReconfigure(int32_t frames, int32_t rate) const
+{
+  auto onReconfigure = _params.stream.onReconfigure;
+  if(onReconfigure != nullptr) onReconfigure(this, frames, rate, _user);
 }
 
 void
-XtStream::OnRunning(XtBool running, XtFault fault) const
+XtStream::OnRunning(XtBool running, XtFault fault)
 {
+  _queue.OnRunning(running != XtFalse);
   auto onRunning = _params.stream.onRunning;
   if(onRunning != nullptr) onRunning(this, running, XtiCreateError(GetSystem(), fault), _user);
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #ifndef XT_PRIVATE_STREAM_HPP
 #define XT_PRIVATE_STREAM_HPP
 
+#include <xt/shared/Queue.hpp>
+#include <xt/shared/Recorder.hpp>
+#include <xt/shared/Watchdog.hpp>
 #include <xt/private/StreamBase.hpp>
 
 #define XT_IMPLEMENT_STREAM()     \
@@ -14,6 +17,9 @@ public XtStreamBase
   void* _user;
   bool _emulated;
   XtIOBuffers _buffers;
+  XtQueue _queue;
+  XtRecorder _recorder;
+  XtWatchdog _watchdog;
   XtDeviceStreamParams _params;
 
   virtual void Stop() = 0;
@@ -22,7 +28,9 @@ public XtStreamBase
 
   XtStream() = default;  
   void OnXRun(int32_t index) const override final;
-  void OnRunning(XtBool running, XtFault fault) const;
+  void OnRunning(XtBool running, XtFault fault);
+  void OnReconfigure(int32_t frames, int32_t rate) const;
+  XtFault OnAppBuffer(XtBuffer const* buffer);
   XtFault OnBuffer(int32_t index, XtBuffer const* buffer) override;
 };
 
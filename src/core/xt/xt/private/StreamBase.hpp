@@ -17,6 +17,10 @@ struct XtStreamBase
 {
   XtStreamBase() = default;
   virtual ~XtStreamBase() { };
+  virtual void Rewind() { }
+  virtual XtFault SetPaused(XtBool paused) { return 0; }
+  virtual XtFault SetFreewheel(XtBool freewheel) { return 0; }
+  virtual XtFault SetBufferSize(double bufferSize) { return 0; }
 
   virtual void* GetHandle() const = 0;
   virtual XtSystem GetSystem() const = 0;
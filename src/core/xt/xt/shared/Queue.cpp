@@ -0,0 +1,131 @@
+#include <xt/shared/Queue.hpp>
+
+#include <vector>
+#include <chrono>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/eventfd.h>
+#endif // __linux__
+
+static void*
+XtiQueueOffset(XtSpscRing const& ring, void* data, int32_t frames, std::vector<uint8_t*>& channels)
+{
+  if(ring._interleaved) return static_cast<uint8_t*>(data) + frames * ring._channels * ring._sampleSize;
+  for(int32_t c = 0; c < ring._channels; c++)
+    channels[c] = static_cast<uint8_t**>(data)[c] + frames * ring._sampleSize;
+  return channels.data();
+}
+
+XtQueue::
+XtQueue():
+_active(false), _primed(false), _readyFd(-1), 
+_prebuffer(0), _readyFrames(0), _lock(), _rings(), 
+_running(false), _signal(), _overflows(0), _underflows(0) { }
+
+XtQueue::
+~XtQueue()
+{
+#ifdef __linux__
+  if(_readyFd != -1) close(_readyFd);
+#endif // __linux__
+}
+
+void
+XtQueue::OnRunning(bool running)
+{
+  _running.store(running);
+  if(!running) _primed = false;
+  _signal.notify_all();
+  if(!running) SignalReady();
+}
+
+// Signals the event loop when either ring crossed the threshold. The 
+// eventfd counts signals until the application reads it, so it stays 
+// readable until the application catches up.
+void
+XtQueue::SignalReady()
+{
+#ifdef __linux__
+  int32_t frames = _readyFrames.load();
+  if(_readyFd == -1) return;
+  auto const& input = _rings.input;
+  auto const& output = _rings.output;
+  bool ready = !_running.load();
+  ready |= input._channels > 0 && input.Full() >= frames;
+  ready |= output._channels > 0 && output._frames - output.Full() >= frames;
+  if(ready) eventfd_write(_readyFd, 1);
+#endif // __linux__
+}
+
+int32_t
+XtQueue::GetReadyFd(int32_t frames)
+{
+#ifdef __linux__
+  _readyFrames.store(frames);
+  if(_readyFd == -1) XT_TRACE_IF((_readyFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) == -1);
+  if(_readyFd != -1) SignalReady();
+#endif // __linux__
+  return _readyFd;
+}
+
+void
+XtQueue::GetStats(XtRingStats* stats) const
+{
+  if(!_active) return;
+  stats->overflows = _overflows.load();
+  stats->underflows = _underflows.load();
+  stats->readable = _rings.input.Full();
+  stats->writable = _rings.output._frames - _rings.output.Full();
+}
+
+void
+XtQueue::Init(XtFormat const* format, XtBool interleaved, int32_t frames, int32_t prebuffer)
+{
+  int32_t size = XtiGetSampleSize(format->mix.sample);
+  _rings.input.Init(interleaved != XtFalse, frames, format->channels.inputs, size);
+  _rings.output.Init(interleaved != XtFalse, frames, format->channels.outputs, size);
+  _active = true;
+  _primed = false;
+  _prebuffer = prebuffer;
+  _overflows.store(0);
+  _underflows.store(0);
+}
+
+void
+XtQueue::OnBuffer(XtBuffer const* buffer)
+{
+  int32_t read = 0;
+  int32_t frames = buffer->frames;
+  auto& output = _rings.output;
+  if(buffer->input != nullptr && _rings.input.Write(buffer->input, frames) < frames) _overflows++;
+  if(buffer->output != nullptr)
+  {
+    if(!_primed) _primed = output.Full() >= _prebuffer;
+    if(_primed) read = output.Read(buffer->output, frames);
+    XtiZeroBuffer(buffer->output, output._interleaved, read, output._channels, frames - read, output._sampleSize);
+    if(_primed && read < frames) _underflows++, _primed = _prebuffer == 0;
+  }
+  _signal.notify_all();
+  SignalReady();
+}
+
+int32_t
+XtQueue::Transfer(XtSpscRing& ring, void* data, int32_t frames, int32_t timeout, bool write)
+{
+  int32_t done = 0;
+  auto now = std::chrono::steady_clock::now();
+  auto deadline = now + std::chrono::milliseconds(timeout);
+  std::vector<uint8_t*> channels(static_cast<size_t>(ring._channels));
+  std::unique_lock<std::mutex> lock(_lock);
+  while(true)
+  {
+    void* at = XtiQueueOffset(ring, data, done, channels);
+    done += write? ring.Write(at, frames - done): ring.Read(at, frames - done);
+    if(done == frames || timeout == 0 || !_running.load()) return done;
+    now = std::chrono::steady_clock::now();
+    if(timeout > 0 && now >= deadline) return done;
+    auto until = now + std::chrono::milliseconds(XtiQueueWaitMs);
+    _signal.wait_until(lock, timeout > 0 && deadline < until? deadline: until);
+  }
+}
\ No newline at end of file
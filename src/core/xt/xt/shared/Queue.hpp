@@ -0,0 +1,58 @@
+#ifndef XT_SHARED_QUEUE_HPP
+#define XT_SHARED_QUEUE_HPP
+
+#include <xt/api/Structs.h>
+#include <xt/shared/Shared.hpp>
+#include <xt/shared/SpscRing.hpp>
+
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <condition_variable>
+
+inline int32_t const
+XtiQueueWaitMs = 10;
+
+// Rings between the audio thread and application threads for streams
+// opened without a buffer callback. The audio thread fills the input
+// ring and drains the output ring, and only signals waiters. The rings
+// are lock-free, so it never waits on application threads; these only
+// serialize among themselves on the queue lock. Waiters also poll, so
+// a missed signal costs at most one wait interval. On linux, readiness
+// is also signaled on an eventfd for event loops.
+struct XtQueue
+{
+  bool _active;
+  bool _primed;
+  int _readyFd;
+  int32_t _prebuffer;
+  std::atomic_int _readyFrames;
+  std::mutex _lock;
+  XtIOSpscRings _rings;
+  std::atomic_bool _running;
+  std::condition_variable _signal;
+  std::atomic<uint64_t> _overflows;
+  std::atomic<uint64_t> _underflows;
+
+  ~XtQueue();
+  XtQueue();
+  XtQueue(XtQueue const&) = delete;
+  XtQueue& operator=(XtQueue const&) = delete;
+
+  void
+  SignalReady();
+  void
+  OnRunning(bool running);
+  int32_t
+  GetReadyFd(int32_t frames);
+  void
+  OnBuffer(XtBuffer const* buffer);
+  void
+  GetStats(XtRingStats* stats) const;
+  void
+  Init(XtFormat const* format, XtBool interleaved, int32_t frames, int32_t prebuffer);
+  int32_t
+  Transfer(XtSpscRing& ring, void* data, int32_t frames, int32_t timeout, bool write);
+};
+
+#endif // XT_SHARED_QUEUE_HPP
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include <xt/shared/Recorder.hpp>
+
+#include <thread>
+#include <utility>
+
+XtRecorder::
+XtRecorder():
+_output(false), _channels(0), 
+_interleaved(XtFalse), _state(Idle), _stats() { }
+
+XtRecorder::
+~XtRecorder()
+{ Stop(); }
+bool
+XtRecorder::IsRecording() const
+{ return _state.load() != Idle; }
+
+#if !XT_ENABLE_FILE
+void
+XtRecorder::Stop() { }
+void
+XtRecorder::Write(XtBuffer const* buffer, bool output) { }
+void
+XtRecorder::GetStats(XtRecordingStats* stats) const
+{ *stats = _stats; }
+XtFault
+XtRecorder::Start(char const* path, XtFormat const* format, XtBool interleaved, bool output)
+{ XT_ASSERT(false); return 0; }
+#else // !XT_ENABLE_FILE
+
+void
+XtRecorder::Stop()
+{
+  if(_state.load() == Idle) return;
+  while(!XtiCompareExchange(_state, Active, Idle)) std::this_thread::yield();
+  XT_TRACE_IF(_writer->Flush() != 0);
+  GetStats(&_stats);
+  _writer.reset();
+}
+
+void
+XtRecorder::GetStats(XtRecordingStats* stats) const
+{
+  if(!_writer) return void(*stats = _stats);
+  uint64_t flushed = _writer->_flushed.load();
+  uint64_t frameSize = _channels * XtiGetSampleSize(_writer->_mix.sample);
+  stats->dropped = _writer->_dropped.load();
+  stats->written = flushed / frameSize;
+  stats->lag = (_writer->_written.load() - flushed) / frameSize;
+}
+
+void
+XtRecorder::Write(XtBuffer const* buffer, bool output)
+{
+  if(output != _output || buffer->frames <= 0) return;
+  void const* data = output? buffer->output: buffer->input;
+  if(data == nullptr || !XtiCompareExchange(_state, Active, Busy)) return;
+  if(!_interleaved) _writer->Write(static_cast<void const* const*>(data), buffer->frames);
+  else _writer->Write(data, static_cast<size_t>(buffer->frames) * _channels * XtiGetSampleSize(_writer->_mix.sample));
+  _state.store(Active);
+}
+
+XtFault
+XtRecorder::Start(char const* path, XtFormat const* format, XtBool interleaved, bool output)
+{
+  XtFault fault;
+  auto writer = std::make_unique<XtWavWriter>();
+  auto channels = output? format->channels.outputs: format->channels.inputs;
+  if((fault = writer->Open(path, format->mix, channels)) != 0) return fault;
+  _stats = XtRecordingStats();
+  _output = output;
+  _channels = channels;
+  _interleaved = interleaved;
+  _writer = std::move(writer);
+  _state.store(Active);
+  return 0;
+}
+
+#endif // !XT_ENABLE_FILE
\ No newline at end of file
@@ -0,0 +1,46 @@
+#ifndef XT_SHARED_RECORDER_HPP
+#define XT_SHARED_RECORDER_HPP
+
+#include <xt/api/Structs.h>
+#include <xt/shared/Shared.hpp>
+#include <xt/shared/Wav.hpp>
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+// Copies the input or output of a stream to a WAV/RF64 file. Started
+// and stopped by the main thread, possibly while the stream is running.
+// The audio thread only writes while it holds the recorder active, so
+// Stop never tears down the writer underneath it.
+struct XtRecorder
+{
+  enum State { Idle, Active, Busy };
+
+  bool _output;
+  int32_t _channels;
+  XtBool _interleaved;
+  std::atomic_int _state;
+  XtRecordingStats _stats;
+#if XT_ENABLE_FILE
+  std::unique_ptr<XtWavWriter> _writer;
+#endif // XT_ENABLE_FILE
+
+  ~XtRecorder();
+  XtRecorder();
+  XtRecorder(XtRecorder const&) = delete;
+  XtRecorder& operator=(XtRecorder const&) = delete;
+
+  void
+  Stop();
+  bool
+  IsRecording() const;
+  void
+  GetStats(XtRecordingStats* stats) const;
+  void
+  Write(XtBuffer const* buffer, bool output);
+  XtFault
+  Start(char const* path, XtFormat const* format, XtBool interleaved, bool output);
+};
+
+#endif // XT_SHARED_RECORDER_HPP
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include <xt/shared/RtCheck.hpp>
+
+#if !XT_ENABLE_RT_CHECK
+void
+XtiRtViolation() { }
+uint64_t
+XtiGetRtViolations() { return 0; }
+XtRtScope::
+XtRtScope(bool hot): _previous(false) { }
+XtRtScope::
+~XtRtScope() { }
+#else // !XT_ENABLE_RT_CHECK
+
+#include <new>
+#include <atomic>
+#include <cstdlib>
+#ifdef __linux__
+#include <dlfcn.h>
+#include <pthread.h>
+#endif // __linux__
+
+// Initial-exec keeps the flag in static TLS, so reading it from the 
+// allocation hooks below never allocates itself.
+static thread_local bool 
+XtiRtHot __attribute__((tls_model("initial-exec"))) = false;
+static std::atomic<uint64_t>
+XtiRtViolations(0);
+
+uint64_t
+XtiGetRtViolations()
+{ return XtiRtViolations.load(); }
+void
+XtiRtViolation()
+{ if(XtiRtHot) XtiRtViolations.fetch_add(1); }
+
+XtRtScope::
+XtRtScope(bool hot):
+_previous(XtiRtHot) { XtiRtHot = hot; }
+XtRtScope::
+~XtRtScope()
+{ XtiRtHot = _previous; }
+
+#ifdef __linux__
+// Interpose the glibc entry points process-wide, which also covers 
+// operator new and std::mutex. The real mutex lock is no longer 
+// exported under an internal name, so resolve it once at load time.
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t count, size_t size);
+extern "C" void* __libc_realloc(void* p, size_t size);
+
+typedef int (*XtMutexLock)(pthread_mutex_t*);
+static XtMutexLock
+XtiRtMutexLock = nullptr;
+
+__attribute__((constructor(101))) static void
+XtiRtResolveMutexLock()
+{
+  if(XtiRtMutexLock != nullptr) return;
+  XtiRtMutexLock = reinterpret_cast<XtMutexLock>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+}
+
+extern "C" void* 
+malloc(size_t size)
+{ XtiRtViolation(); return __libc_malloc(size); }
+extern "C" void* 
+calloc(size_t count, size_t size)
+{ XtiRtViolation(); return __libc_calloc(count, size); }
+extern "C" void* 
+realloc(void* p, size_t size)
+{ XtiRtViolation(); return __libc_realloc(p, size); }
+extern "C" int 
+pthread_mutex_lock(pthread_mutex_t* mutex)
+{
+  XtiRtViolation();
+  XtiRtResolveMutexLock();
+  return XtiRtMutexLock(mutex);
+}
+#else // __linux__
+void* 
+operator new(size_t size)
+{
+  XtiRtViolation();
+  void* result = std::malloc(size);
+  if(result == nullptr) throw std::bad_alloc();
+  return result;
+}
+void 
+operator delete(void* p) noexcept
+{ std::free(p); }
+#endif // __linux__
+
+#endif // !XT_ENABLE_RT_CHECK
\ No newline at end of file
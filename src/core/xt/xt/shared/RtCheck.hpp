@@ -0,0 +1,30 @@
+#ifndef XT_SHARED_RT_CHECK_HPP
+#define XT_SHARED_RT_CHECK_HPP
+
+#include <cstdint>
+
+#if XT_ENABLE_RT_CHECK
+#define XT_RT_CHECK_CONCAT_(a, b) a##b
+#define XT_RT_CHECK_CONCAT(a, b) XT_RT_CHECK_CONCAT_(a, b)
+#define XT_RT_SCOPE(hot) XtRtScope XT_RT_CHECK_CONCAT(xtRtScope, __LINE__)(hot)
+#else
+#define XT_RT_SCOPE(hot) ((void)0)
+#endif // XT_ENABLE_RT_CHECK
+
+void
+XtiRtViolation();
+uint64_t
+XtiGetRtViolations();
+
+// Marks the calling thread as running (hot = true) or suspending 
+// (hot = false, around application code) the library's real-time path.
+// Instrumented builds count heap allocations and mutex locks made
+// while the mark is set. Scopes nest.
+struct XtRtScope
+{
+  bool _previous;
+  explicit XtRtScope(bool hot);
+  ~XtRtScope();
+};
+
+#endif // XT_SHARED_RT_CHECK_HPP
\ No newline at end of file
@@ -52,4 +52,13 @@ XtiCreateWasapiService()
 XtServiceError
 XtiGetWasapiError(XtFault fault) 
 { XT_ASSERT(false); return XtServiceError(); }
-#endif // !XT_ENABLE_WASAPI
\ No newline at end of file
+#endif // !XT_ENABLE_WASAPI
+
+#if !XT_ENABLE_FILE
+std::unique_ptr<XtService>
+XtiCreateFileService()
+{ return std::unique_ptr<XtService>(); }
+XtServiceError
+XtiGetFileError(XtFault fault) 
+{ XT_ASSERT(false); return XtServiceError(); }
+#endif // !XT_ENABLE_FILE
\ No newline at end of file
@@ -39,4 +39,9 @@ XtiCreateDSoundService();
 XtServiceError
 XtiGetDSoundError(XtFault fault);
 
+std::unique_ptr<XtService>
+XtiCreateFileService();
+XtServiceError
+XtiGetFileError(XtFault fault);
+
 #endif // XT_SHARED_SERVICES_HPP
\ No newline at end of file
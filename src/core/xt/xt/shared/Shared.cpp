@@ -90,6 +90,7 @@ XtiGetServiceError(XtSystem system, XtFault fault)
   case XtSystemPulse: return XtiGetPulseError(fault);
   case XtSystemWASAPI: return XtiGetWasapiError(fault);
   case XtSystemDSound: return XtiGetDSoundError(fault);
+  case XtSystemFile: return XtiGetFileError(fault);
   default: XT_ASSERT(false); return XtServiceError();
   }
 }
@@ -0,0 +1,73 @@
+#include <xt/shared/SpscRing.hpp>
+
+#include <cstring>
+#include <algorithm>
+
+XtSpscRing::
+XtSpscRing():
+_frames(0), _channels(0), _interleaved(false),
+_sampleSize(0), _read(0), _written(0), _blocks() { }
+
+// Reading the consumer position first keeps the result in range
+// even while both sides move on.
+int32_t
+XtSpscRing::Full() const
+{
+  uint64_t read = _read.load(std::memory_order_acquire);
+  uint64_t written = _written.load(std::memory_order_acquire);
+  return static_cast<int32_t>(std::min<uint64_t>(written - read, static_cast<uint64_t>(_frames)));
+}
+
+void
+XtSpscRing::Init(bool interleaved, int32_t frames, int32_t channels, int32_t size)
+{
+  _frames = frames;
+  _channels = channels;
+  _sampleSize = size;
+  _interleaved = interleaved;
+  _read.store(0);
+  _written.store(0);
+  size_t blocks = interleaved? 1: static_cast<size_t>(channels);
+  size_t bytes = static_cast<size_t>(frames) * size * (interleaved? channels: 1);
+  _blocks = std::vector<std::vector<uint8_t>>(blocks, std::vector<uint8_t>(bytes, 0));
+}
+
+int32_t
+XtSpscRing::Read(void* target, int32_t frames)
+{
+  uint64_t read = _read.load(std::memory_order_relaxed);
+  uint64_t written = _written.load(std::memory_order_acquire);
+  int32_t result = std::min(frames, static_cast<int32_t>(written - read));
+  Copy(target, static_cast<int32_t>(read % _frames), result, false);
+  _read.store(read + result, std::memory_order_release);
+  return result;
+}
+
+int32_t
+XtSpscRing::Write(void const* source, int32_t frames)
+{
+  uint64_t read = _read.load(std::memory_order_acquire);
+  uint64_t written = _written.load(std::memory_order_relaxed);
+  int32_t result = std::min(frames, _frames - static_cast<int32_t>(written - read));
+  Copy(const_cast<void*>(source), static_cast<int32_t>(written % _frames), result, true);
+  _written.store(written + result, std::memory_order_release);
+  return result;
+}
+
+// Moves frames between the caller's buffer and the ring starting at
+// position, wrapping around the end of the ring at most once.
+void
+XtSpscRing::Copy(void* data, int32_t position, int32_t frames, bool write)
+{
+  int32_t split = std::min(frames, _frames - position);
+  size_t size = static_cast<size_t>(_sampleSize) * (_interleaved? _channels: 1);
+  for(size_t b = 0; b < _blocks.size(); b++)
+  {
+    uint8_t* ring = _blocks[b].data();
+    uint8_t* user = _interleaved? static_cast<uint8_t*>(data): static_cast<uint8_t**>(data)[b];
+    uint8_t* at = ring + position * size;
+    uint8_t* wrap = user + split * size;
+    if(write) memcpy(at, user, split * size), memcpy(ring, wrap, (frames - split) * size);
+    else memcpy(user, at, split * size), memcpy(wrap, ring, (frames - split) * size);
+  }
+}
\ No newline at end of file
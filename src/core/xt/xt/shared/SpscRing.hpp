@@ -0,0 +1,47 @@
+#ifndef XT_SHARED_SPSC_RING_HPP
+#define XT_SHARED_SPSC_RING_HPP
+
+#include <xt/shared/Shared.hpp>
+
+#include <atomic>
+#include <vector>
+#include <cstdint>
+
+// Single producer, single consumer ring without locks, so neither side
+// can hold up the other. Positions count frames and only grow. Each side
+// copies, then publishes its own position with release semantics, and
+// acquires the other side's. Init may only be called while neither side
+// runs. Full may be called from any thread.
+struct XtSpscRing
+{
+  int32_t _frames;
+  int32_t _channels;
+  bool _interleaved;
+  int32_t _sampleSize;
+  std::atomic<uint64_t> _read;
+  std::atomic<uint64_t> _written;
+  std::vector<std::vector<uint8_t>> _blocks;
+
+  XtSpscRing();
+  XtSpscRing(XtSpscRing const&) = delete;
+  XtSpscRing& operator=(XtSpscRing const&) = delete;
+
+  int32_t
+  Full() const;
+  int32_t
+  Read(void* target, int32_t frames);
+  int32_t
+  Write(void const* source, int32_t frames);
+  void
+  Copy(void* data, int32_t position, int32_t frames, bool write);
+  void
+  Init(bool interleaved, int32_t frames, int32_t channels, int32_t size);
+};
+
+struct XtIOSpscRings
+{
+  XtSpscRing input;
+  XtSpscRing output;
+};
+
+#endif // XT_SHARED_SPSC_RING_HPP
\ No newline at end of file
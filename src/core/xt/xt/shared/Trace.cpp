@@ -0,0 +1,115 @@
+#include <xt/shared/Trace.hpp>
+#include <xt/shared/RtCheck.hpp>
+
+#include <vector>
+#include <cstdio>
+#include <algorithm>
+
+#if !XT_ENABLE_TRACE
+int64_t
+XtiTraceNow() { return 0; }
+XtTraceRing*
+XtiGetTraceRing() { return nullptr; }
+XtBool
+XtiWriteTrace(char const* path) { return XtFalse; }
+XtTraceSpan::
+~XtTraceSpan() { }
+#else // !XT_ENABLE_TRACE
+
+// Returns the ring when the thread exits. Spans recorded later on, from
+// other thread-local destructors, are dropped.
+struct XtTraceLease
+{
+  XtTraceRing* ring = nullptr;
+  ~XtTraceLease();
+};
+
+static std::atomic<int32_t>
+XtiTraceThreads(0);
+static XtTraceRing
+XtiTraceRings[XtiTraceRingCount];
+static thread_local bool
+XtiTraceExited = false;
+static thread_local XtTraceRing*
+XtiTraceCurrent = nullptr;
+static std::chrono::steady_clock::time_point const
+XtiTraceEpoch = std::chrono::steady_clock::now();
+
+XtTraceLease::
+~XtTraceLease()
+{
+  XtiTraceExited = true;
+  XtiTraceCurrent = nullptr;
+  if(ring != nullptr) ring->leased.store(false, std::memory_order_release);
+}
+
+int64_t
+XtiTraceNow()
+{ 
+  auto elapsed = std::chrono::steady_clock::now() - XtiTraceEpoch;
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(); 
+}
+
+// The lease is registered for destruction on first use, which the C++
+// runtime may allocate for. Tracing is diagnostic, that is not a violation.
+XtTraceRing*
+XtiGetTraceRing()
+{
+  if(XtiTraceCurrent != nullptr || XtiTraceExited) return XtiTraceCurrent;
+  XT_RT_SCOPE(false);
+  thread_local XtTraceLease lease;
+  for(auto& ring: XtiTraceRings)
+  {
+    bool leased = false;
+    if(!ring.leased.compare_exchange_strong(leased, true, std::memory_order_acquire)) continue;
+    ring.thread = XtiTraceThreads.fetch_add(1) + 1;
+    lease.ring = &ring;
+    XtiTraceCurrent = &ring;
+    return XtiTraceCurrent;
+  }
+  return nullptr;
+}
+
+XtTraceSpan::
+~XtTraceSpan()
+{
+  XtTraceRing* ring = XtiGetTraceRing();
+  if(ring == nullptr) return;
+  uint64_t written = ring->written.load(std::memory_order_relaxed);
+  ring->records[written % XtiTraceRingSize] = { _name, _begin, XtiTraceNow(), ring->thread };
+  ring->written.store(written + 1, std::memory_order_release);
+}
+
+// Chrome trace event format, also understood by Perfetto.
+XtBool
+XtiWriteTrace(char const* path)
+{
+  bool first = true;
+  std::vector<XtTraceRecord> records;
+  std::FILE* file = std::fopen(path, "w");
+  if(file == nullptr) return XtFalse;
+  std::fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+  for(auto const& ring: XtiTraceRings)
+  {
+    uint64_t end = ring.written.load(std::memory_order_acquire);
+    uint64_t begin = end > XtiTraceRingSize? end - XtiTraceRingSize: 0;
+    records.clear();
+    for(uint64_t i = begin; i < end; i++) records.push_back(ring.records[i % XtiTraceRingSize]);
+    // Record n may be overwritten by record n + size, which is in flight
+    // while written is n + size. Anything below written + 1 - size is gone.
+    uint64_t overwritten = ring.written.load(std::memory_order_acquire) + 1;
+    uint64_t valid = overwritten > XtiTraceRingSize? overwritten - XtiTraceRingSize: 0;
+    size_t skip = static_cast<size_t>(std::min(std::max(valid, begin) - begin, end - begin));
+    for(size_t i = skip; i < records.size(); i++)
+    {
+      auto const& r = records[i];
+      std::fprintf(file, "%s\n{\"name\":\"%s\",\"cat\":\"xt\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+        first? "": ",", r.name, r.thread, r.begin / 1000.0, (r.end - r.begin) / 1000.0);
+      first = false;
+    }
+  }
+  std::fprintf(file, "\n]}\n");
+  return std::fclose(file) == 0? XtTrue: XtFalse;
+}
+
+#endif // !XT_ENABLE_TRACE
\ No newline at end of file
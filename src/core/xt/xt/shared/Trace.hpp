@@ -0,0 +1,66 @@
+#ifndef XT_SHARED_TRACE_HPP
+#define XT_SHARED_TRACE_HPP
+
+#include <xt/api/Shared.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if XT_ENABLE_TRACE
+#define XT_TRACE_CONCAT_(a, b) a##b
+#define XT_TRACE_CONCAT(a, b) XT_TRACE_CONCAT_(a, b)
+#define XT_TRACE_SPAN(name) XtTraceSpan XT_TRACE_CONCAT(xtTraceSpan, __LINE__)(name)
+#else
+#define XT_TRACE_SPAN(name) ((void)0)
+#endif // XT_ENABLE_TRACE
+
+inline size_t const
+XtiTraceRingSize = 16384;
+inline size_t const
+XtiTraceRingCount = 16;
+
+struct XtTraceRecord
+{
+  char const* name;
+  int64_t begin;
+  int64_t end;
+  int32_t thread;
+};
+
+// Ring of completed spans, leased by one thread at a time from a fixed
+// pool and handed back when the thread exits. Only the leasing thread
+// writes, the oldest records are overwritten when full. A ring keeps its
+// records across leases, each record names the thread that wrote it.
+// Readers copy records and then discard any the writer may have
+// overwritten in the meantime, or may still be writing.
+struct XtTraceRing
+{
+  int32_t thread;
+  std::atomic<bool> leased;
+  std::atomic<uint64_t> written;
+  std::array<XtTraceRecord, XtiTraceRingSize> records;
+};
+
+int64_t
+XtiTraceNow();
+XtTraceRing*
+XtiGetTraceRing();
+XtBool
+XtiWriteTrace(char const* path);
+
+// Times the enclosing scope. Leases a ring for the calling thread on
+// first use, after that recording is wait-free. Spans are dropped while
+// all rings are leased.
+struct XtTraceSpan
+{
+  char const* _name;
+  int64_t _begin;
+
+  XtTraceSpan(char const* name):
+  _name(name), _begin(XtiTraceNow()) { }
+  ~XtTraceSpan();
+};
+
+#endif // XT_SHARED_TRACE_HPP
\ No newline at end of file
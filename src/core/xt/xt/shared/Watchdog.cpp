@@ -0,0 +1,62 @@
+#include <xt/shared/Watchdog.hpp>
+
+XtWatchdog::
+XtWatchdog():
+_active(false), _user(nullptr), _fraction(0.0),
+_stream(nullptr), _closing(0), _worst(0), _budget(0),
+_onExceeded(nullptr), _thread() { }
+
+XtWatchdog::
+~XtWatchdog()
+{ Stop(); }
+
+XtWatchdog::Clock::time_point
+XtWatchdog::Begin() const
+{ return _active? Clock::now(): Clock::time_point(); }
+
+void
+XtWatchdog::Stop()
+{
+  _active = false;
+  if(!_thread.joinable()) return;
+  _closing.store(1);
+  _thread.join();
+}
+
+void
+XtWatchdog::Start(XtStream const* stream, void* user, double fraction, XtOnBudgetExceeded onExceeded)
+{
+  Stop();
+  _user = user;
+  _stream = stream;
+  _fraction = fraction;
+  _onExceeded = onExceeded;
+  _worst.store(0);
+  _closing.store(0);
+  _active = true;
+  _thread = std::thread(&XtWatchdog::RunWatchdog, this);
+}
+
+void
+XtWatchdog::End(Clock::time_point start, int32_t frames, int32_t rate)
+{
+  if(!_active) return;
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+  auto budget = static_cast<int64_t>(frames * 1.0e9 * _fraction / rate);
+  if(elapsed <= budget || elapsed <= _worst.load()) return;
+  _budget.store(budget);
+  _worst.store(elapsed);
+}
+
+void
+XtWatchdog::RunWatchdog(XtWatchdog* watchdog)
+{
+  int64_t worst;
+  while(watchdog->_closing.load() == 0)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(XtiWatchdogPollMs));
+    if((worst = watchdog->_worst.exchange(0)) == 0) continue;
+    double budget = watchdog->_budget.load() / 1.0e6;
+    watchdog->_onExceeded(watchdog->_stream, worst / 1.0e6, budget, watchdog->_user);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef XT_SHARED_WATCHDOG_HPP
+#define XT_SHARED_WATCHDOG_HPP
+
+#include <xt/api/Callbacks.h>
+#include <xt/shared/Shared.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+
+inline int32_t const
+XtiWatchdogPollMs = 10;
+
+// Times the application callback against the buffer period. The audio 
+// thread only records the worst overrun since the last report, a
+// background thread polls and reports it, so the notification never 
+// runs on the audio thread. Configured while the stream is stopped.
+struct XtWatchdog
+{
+  typedef std::chrono::steady_clock Clock;
+
+  bool _active;
+  void* _user;
+  double _fraction;
+  XtStream const* _stream;
+  std::atomic_int _closing;
+  std::atomic<int64_t> _worst;
+  std::atomic<int64_t> _budget;
+  XtOnBudgetExceeded _onExceeded;
+  std::thread _thread;
+
+  ~XtWatchdog();
+  XtWatchdog();
+  XtWatchdog(XtWatchdog const&) = delete;
+  XtWatchdog& operator=(XtWatchdog const&) = delete;
+
+  void
+  Stop();
+  Clock::time_point
+  Begin() const;
+  void
+  End(Clock::time_point start, int32_t frames, int32_t rate);
+  void
+  Start(XtStream const* stream, void* user, double fraction, XtOnBudgetExceeded onExceeded);
+  static void
+  RunWatchdog(XtWatchdog* watchdog);
+};
+
+#endif // XT_SHARED_WATCHDOG_HPP
\ No newline at end of file
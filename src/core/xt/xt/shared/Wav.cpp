@@ -0,0 +1,288 @@
+#ifdef __linux__
+#include <xt/api/XtAudio.h>
+#include <xt/shared/Wav.hpp>
+
+#include <fcntl.h>
+#include <errno.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+
+static uint8_t const
+XtiWavSubFormat[16] = { 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71 };
+
+static uint16_t
+XtiWavGet16(uint8_t const* p)
+{ return static_cast<uint16_t>(p[0] | p[1] << 8); }
+static uint32_t
+XtiWavGet32(uint8_t const* p)
+{ return XtiWavGet16(p) | static_cast<uint32_t>(XtiWavGet16(p + 2)) << 16; }
+static uint64_t
+XtiWavGet64(uint8_t const* p)
+{ return XtiWavGet32(p) | static_cast<uint64_t>(XtiWavGet32(p + 4)) << 32; }
+
+static void
+XtiWavPut16(uint8_t* p, uint16_t v)
+{ p[0] = static_cast<uint8_t>(v); p[1] = static_cast<uint8_t>(v >> 8); }
+static void
+XtiWavPut32(uint8_t* p, uint32_t v)
+{ XtiWavPut16(p, static_cast<uint16_t>(v)); XtiWavPut16(p + 2, static_cast<uint16_t>(v >> 16)); }
+static void
+XtiWavPut64(uint8_t* p, uint64_t v)
+{ XtiWavPut32(p, static_cast<uint32_t>(v)); XtiWavPut32(p + 4, static_cast<uint32_t>(v >> 32)); }
+
+static XtFault
+XtiWavPWrite(int fd, void const* data, size_t size, uint64_t offset)
+{
+  ssize_t written;
+  auto bytes = static_cast<uint8_t const*>(data);
+  while(size > 0)
+  {
+    if((written = pwrite(fd, bytes, size, static_cast<off_t>(offset))) > 0)
+    {
+      size -= written;
+      bytes += written;
+      offset += written;
+    }
+    else if(written == -1 && errno == EINTR) continue;
+    else return written == -1? errno: EIO;
+  }
+  return 0;
+}
+
+static bool
+XtiWavGetSample(uint16_t tag, uint16_t bits, XtSample* sample)
+{
+  if(tag == 3 && bits == 32) return *sample = XtSampleFloat32, true;
+  if(tag != 1) return false;
+  switch(bits)
+  {
+  case 8: *sample = XtSampleUInt8; return true;
+  case 16: *sample = XtSampleInt16; return true;
+  case 24: *sample = XtSampleInt24; return true;
+  case 32: *sample = XtSampleInt32; return true;
+  default: return false;
+  }
+}
+
+bool
+XtiParseWav(void const* data, uint64_t size, XtWavInfo* info)
+{
+  uint64_t ds64 = 0;
+  bool haveFormat = false;
+  auto p = static_cast<uint8_t const*>(data);
+  if(size < 12 || memcmp(p + 8, "WAVE", 4)) return false;
+  bool rf64 = !memcmp(p, "RF64", 4);
+  if(!rf64 && memcmp(p, "RIFF", 4)) return false;
+
+  for(uint64_t pos = 12; pos + 8 <= size; )
+  {
+    uint8_t const* body = p + pos + 8;
+    uint64_t avail = size - pos - 8;
+    uint32_t chunk = XtiWavGet32(p + pos + 4);
+    if(!memcmp(p + pos, "ds64", 4) && chunk >= 24 && avail >= 24)
+      ds64 = XtiWavGet64(body + 8);
+    else if(!memcmp(p + pos, "fmt ", 4) && chunk >= 16 && avail >= 16)
+    {
+      uint16_t tag = XtiWavGet16(body);
+      uint16_t bits = XtiWavGet16(body + 14);
+      if(tag == 0xFFFE && chunk >= 40 && avail >= 40) tag = XtiWavGet16(body + 24);
+      if(!XtiWavGetSample(tag, bits, &info->mix.sample)) return false;
+      info->channels = XtiWavGet16(body + 2);
+      info->mix.rate = static_cast<int32_t>(XtiWavGet32(body + 4));
+      if(info->channels <= 0 || info->mix.rate <= 0) return false;
+      if(XtiWavGet16(body + 12) != info->channels * bits / 8) return false;
+      haveFormat = true;
+    }
+    else if(!memcmp(p + pos, "data", 4))
+    {
+      if(!haveFormat) return false;
+      uint64_t bytes = rf64 && chunk == 0xFFFFFFFF? ds64: chunk;
+      info->offset = pos + 8;
+      info->frames = std::min(bytes, avail) / (info->channels * XtiGetSampleSize(info->mix.sample));
+      return true;
+    }
+    pos += 8 + static_cast<uint64_t>(chunk) + (chunk & 1);
+  }
+  return false;
+}
+
+void
+XtiWriteWavHeader(uint8_t* header, XtMix const& mix, int32_t channels, uint64_t bytes)
+{
+  auto attrs = XtAudioGetSampleAttributes(mix.sample);
+  auto blockAlign = static_cast<uint16_t>(channels * attrs.size);
+  uint64_t riff = XtiWavHeaderSize - 8 + bytes + (bytes & 1);
+  bool rf64 = riff > 0xFFFFFFFF;
+
+  memset(header, 0, XtiWavHeaderSize);
+  memcpy(header, rf64? "RF64": "RIFF", 4);
+  XtiWavPut32(header + 4, rf64? 0xFFFFFFFF: static_cast<uint32_t>(riff));
+  memcpy(header + 8, "WAVE", 4);
+  memcpy(header + 12, rf64? "ds64": "JUNK", 4);
+  XtiWavPut32(header + 16, 28);
+  if(rf64) XtiWavPut64(header + 20, riff);
+  if(rf64) XtiWavPut64(header + 28, bytes);
+  if(rf64) XtiWavPut64(header + 36, bytes / blockAlign);
+
+  memcpy(header + 48, "fmt ", 4);
+  XtiWavPut32(header + 52, 40);
+  XtiWavPut16(header + 56, 0xFFFE);
+  XtiWavPut16(header + 58, static_cast<uint16_t>(channels));
+  XtiWavPut32(header + 60, static_cast<uint32_t>(mix.rate));
+  XtiWavPut32(header + 64, static_cast<uint32_t>(mix.rate) * blockAlign);
+  XtiWavPut16(header + 68, blockAlign);
+  XtiWavPut16(header + 70, static_cast<uint16_t>(attrs.size * 8));
+  XtiWavPut16(header + 72, 22);
+  XtiWavPut16(header + 74, static_cast<uint16_t>(attrs.size * 8));
+  memcpy(header + 80, XtiWavSubFormat, sizeof(XtiWavSubFormat));
+  header[80] = attrs.isFloat? 3: 1;
+
+  memcpy(header + 96, "data", 4);
+  XtiWavPut32(header + 100, rf64? 0xFFFFFFFF: static_cast<uint32_t>(bytes));
+}
+
+XtWavWriter::
+XtWavWriter():
+_fd(-1), _mix(), _channels(0), _ring(),
+_flush(0), _fault(0), _closing(0),
+_written(0), _flushed(0), _dropped(0),
+_allocated(0), _thread() { }
+
+XtWavWriter::
+~XtWavWriter()
+{
+  if(_thread.joinable())
+  {
+    XT_TRACE_IF(Flush() != 0);
+    _closing.store(1);
+    _thread.join();
+  }
+  if(_fd != -1) close(_fd);
+}
+
+size_t
+XtWavWriter::GetFree() const
+{ return _ring.size() - static_cast<size_t>(_written.load() - _flushed.load()); }
+
+XtFault
+XtWavWriter::Open(char const* path, XtMix const& mix, int32_t channels)
+{
+  XtFault fault;
+  auto attrs = XtAudioGetSampleAttributes(mix.sample);
+  double rate = static_cast<double>(mix.rate) * channels * attrs.size;
+  size_t frameSize = static_cast<size_t>(channels * attrs.size);
+  size_t size = std::max(static_cast<size_t>(rate * XtiWavRingSeconds), XtiWavMinRingSize);
+  if((_fd = open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)) == -1) return errno;
+  _mix = mix;
+  _channels = channels;
+  _ring = std::vector<uint8_t>(size - size % frameSize, 0);
+  if((fault = WriteHeader()) != 0) return fault;
+  _thread = std::thread(&XtWavWriter::RunWriter, this);
+  return 0;
+}
+
+XtFault
+XtWavWriter::Flush()
+{
+  if(!_thread.joinable()) return 0;
+  _flush.store(1);
+  while(_flush.load() == 1)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  return _fault.load();
+}
+
+bool
+XtWavWriter::Write(void const* data, size_t bytes)
+{
+  auto source = static_cast<uint8_t const*>(data);
+  uint64_t written = _written.load();
+  if(bytes > GetFree()) return _dropped.fetch_add(1), false;
+  size_t start = static_cast<size_t>(written % _ring.size());
+  size_t first = std::min(bytes, _ring.size() - start);
+  memcpy(_ring.data() + start, source, first);
+  memcpy(_ring.data(), source + first, bytes - first);
+  _written.store(written + bytes);
+  return true;
+}
+
+bool
+XtWavWriter::Write(void const* const* data, int32_t frames)
+{
+  int32_t sampleSize = XtiGetSampleSize(_mix.sample);
+  size_t frameSize = static_cast<size_t>(_channels * sampleSize);
+  size_t bytes = static_cast<size_t>(frames) * frameSize;
+  uint64_t written = _written.load();
+  if(bytes > GetFree()) return _dropped.fetch_add(1), false;
+  size_t position = static_cast<size_t>(written % _ring.size());
+  for(int32_t f = 0; f < frames; f++)
+  {
+    for(int32_t c = 0; c < _channels; c++)
+    {
+      auto source = static_cast<uint8_t const*>(data[c]) + f * sampleSize;
+      memcpy(_ring.data() + position + c * sampleSize, source, sampleSize);
+    }
+    position += frameSize;
+    if(position == _ring.size()) position = 0;
+  }
+  _written.store(written + bytes);
+  return true;
+}
+
+XtFault
+XtWavWriter::WriteHeader()
+{
+  XtFault fault;
+  uint8_t pad = 0;
+  uint8_t header[XtiWavHeaderSize];
+  uint64_t bytes = _flushed.load();
+  XtiWriteWavHeader(header, _mix, _channels, bytes);
+  if((fault = XtiWavPWrite(_fd, header, XtiWavHeaderSize, 0)) != 0) return fault;
+  if((bytes & 1) == 0) return 0;
+  return XtiWavPWrite(_fd, &pad, 1, XtiWavHeaderSize + bytes);
+}
+
+XtFault
+XtWavWriter::WriteRing(bool all)
+{
+  XtFault fault;
+  uint64_t flushed = _flushed.load();
+  uint64_t pending = _written.load() - flushed;
+  while(pending >= XtiWavWriteSize || (all && pending > 0))
+  {
+    size_t start = static_cast<size_t>(flushed % _ring.size());
+    size_t bytes = static_cast<size_t>(std::min<uint64_t>(pending, _ring.size() - start));
+    uint64_t offset = XtiWavHeaderSize + flushed;
+    if(offset + bytes > _allocated)
+    {
+      _allocated = offset + bytes + XtiWavPreallocateSize;
+      auto length = static_cast<off_t>(_allocated - offset);
+      XT_TRACE_IF(fallocate(_fd, FALLOC_FL_KEEP_SIZE, static_cast<off_t>(offset), length) != 0);
+    }
+    if((fault = XtiWavPWrite(_fd, _ring.data() + start, bytes, offset)) != 0) return fault;
+    flushed += bytes;
+    pending -= bytes;
+    _flushed.store(flushed);
+  }
+  return 0;
+}
+
+void
+XtWavWriter::RunWriter(XtWavWriter* writer)
+{
+  XtFault fault;
+  while(writer->_closing.load() == 0)
+  {
+    bool flush = writer->_flush.load() == 1;
+    if(writer->_fault.load() == 0)
+    {
+      if((fault = writer->WriteRing(flush)) == 0 && flush) fault = writer->WriteHeader();
+      if(fault != 0) writer->_fault.store(static_cast<int>(fault));
+    }
+    if(flush) writer->_flush.store(0);
+    else std::this_thread::sleep_for(std::chrono::milliseconds(XtiWavPollMs));
+  }
+}
+
+#endif // __linux__
\ No newline at end of file
@@ -0,0 +1,85 @@
+#ifndef XT_SHARED_WAV_HPP
+#define XT_SHARED_WAV_HPP
+#ifdef __linux__
+#include <xt/shared/Shared.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// RIFF, JUNK (room for ds64), fmt (extensible) and data headers.
+inline size_t const
+XtiWavHeaderSize = 104;
+inline int32_t const
+XtiWavPollMs = 5;
+inline size_t const
+XtiWavWriteSize = 256 * 1024;
+inline uint64_t const
+XtiWavPreallocateSize = 64 * 1024 * 1024;
+inline double const
+XtiWavRingSeconds = 2.0;
+inline size_t const
+XtiWavMinRingSize = 4 * 1024 * 1024;
+
+struct XtWavInfo
+{
+  XtMix mix;
+  int32_t channels;
+  uint64_t offset;
+  uint64_t frames;
+};
+
+bool
+XtiParseWav(void const* data, uint64_t size, XtWavInfo* info);
+void
+XtiWriteWavHeader(uint8_t* header, XtMix const& mix, int32_t channels, uint64_t bytes);
+
+// Streams audio to a WAV file, switching to RF64 past 4 GB. Write may
+// be called from the audio thread: it only copies into a preallocated
+// ring holding whole frames, and counts dropped blocks when it is full.
+// A background thread batches the ring contents into large writes on
+// file space preallocated ahead of the write position. Single producer,
+// single consumer.
+struct XtWavWriter
+{
+  int _fd;
+  XtMix _mix;
+  int32_t _channels;
+  std::vector<uint8_t> _ring;
+  std::atomic_int _flush;
+  std::atomic_int _fault;
+  std::atomic_int _closing;
+  std::atomic<uint64_t> _written;
+  std::atomic<uint64_t> _flushed;
+  std::atomic<uint64_t> _dropped;
+  uint64_t _allocated;
+  std::thread _thread;
+
+  ~XtWavWriter();
+  XtWavWriter();
+  XtWavWriter(XtWavWriter const&) = delete;
+  XtWavWriter& operator=(XtWavWriter const&) = delete;
+
+  XtFault
+  Flush();
+  size_t
+  GetFree() const;
+  bool
+  Write(void const* data, size_t bytes);
+  bool
+  Write(void const* const* data, int32_t frames);
+  XtFault
+  Open(char const* path, XtMix const& mix, int32_t channels);
+
+  XtFault
+  WriteHeader();
+  XtFault
+  WriteRing(bool all);
+  static void
+  RunWriter(XtWavWriter* writer);
+};
+
+#endif // __linux__
+#endif // XT_SHARED_WAV_HPP
\ No newline at end of file
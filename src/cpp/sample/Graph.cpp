@@ -0,0 +1,104 @@
+#define _USE_MATH_DEFINES 1
+#include <xt/XtAudio.hpp>
+#include <xt/XtAudioPool.hpp>
+#include <xt/XtAudioGraph.hpp>
+
+#include <cmath>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <cstdint>
+#include <iostream>
+
+// Renders two oscillators mixed to stereo through a graph processed by
+// the callback thread and two workers, to the file backend. Runs once
+// on a regular stream, then again on a stream leased from a pool.
+// Returns nonzero if either stream rendered nothing.
+
+static char const* const Path = "xt-graph.wav";
+static Xt::Mix const Mix(48000, Xt::Sample::Float32);
+static Xt::Format const Format(Mix, Xt::Channels(0, 0, 2, 0));
+
+struct Session
+{
+  Xt::Graph::Graph graph;
+  std::atomic<int32_t> periods;
+  Session(): graph(2), periods(0) { }
+};
+
+static uint32_t
+OnBuffer(Xt::Stream const& stream, Xt::Buffer const& buffer, void* user)
+{
+  auto session = static_cast<Session*>(user);
+  session->graph.Process(buffer);
+  session->periods.fetch_add(1);
+  return 0;
+}
+
+static int32_t
+AddOscillator(Xt::Graph::Graph& graph, double frequency)
+{
+  return graph.Add(1, [frequency, phase = 0.0](Xt::Graph::Context const& context) mutable {
+    auto output = context.Output();
+    for(int32_t f = 0; f < context.Frames(); f++)
+    {
+      phase += frequency / Mix.rate;
+      if(phase >= 1.0) phase -= 1.0;
+      output(f, 0) = static_cast<float>(std::sin(2.0 * M_PI * phase));
+    } });
+}
+
+static void
+Build(Xt::Graph::Graph& graph)
+{
+  int32_t low = AddOscillator(graph, 440.0);
+  int32_t high = AddOscillator(graph, 660.0);
+  int32_t mix = graph.Add(2, [](Xt::Graph::Context const& context) {
+    auto output = context.Output();
+    auto left = context.Input(0);
+    auto right = context.Input(1);
+    for(int32_t f = 0; f < context.Frames(); f++)
+    {
+      output(f, 0) = 0.4f * left(f, 0) + 0.1f * right(f, 0);
+      output(f, 1) = 0.1f * left(f, 0) + 0.4f * right(f, 0);
+    } });
+  graph.Connect(low, mix);
+  graph.Connect(high, mix);
+  graph.SetOutput(mix);
+}
+
+// Pooled streams share the device parameters and therefore the buffer
+// size, so the graph prepared for the first stream fits them as well.
+int
+GraphMain()
+{
+  std::unique_ptr<Xt::Platform> platform = Xt::Audio::Init("", nullptr);
+  std::unique_ptr<Xt::Service> service = platform->GetService(Xt::System::File);
+  if(!service) return 0;
+
+  Session session;
+  Build(session.graph);
+  std::unique_ptr<Xt::Device> device = service->OpenDevice(std::string(Path) + ",TYPE=1");
+  Xt::StreamParams streamParams(false, OnBuffer, nullptr, nullptr);
+  Xt::DeviceStreamParams deviceParams(streamParams, Format, 10.0);
+  {
+    std::unique_ptr<Xt::Stream> stream = device->OpenStream(deviceParams, &session);
+    session.graph.Prepare(*stream);
+    stream->Start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    stream->Stop();
+  }
+  int32_t streamed = session.periods.exchange(0);
+  std::cout << "Stream rendered " << streamed << " periods.\n";
+
+  Xt::Pooling::Pool pool(*service, *device, deviceParams, 1);
+  Xt::Pooling::Lease lease = pool.Acquire(&session);
+  std::this_thread::sleep_for(std::chrono::milliseconds(250));
+  lease.Release();
+  int32_t leased = session.periods.load();
+  std::cout << "Lease rendered " << leased << " periods.\n";
+  std::remove(Path);
+  return streamed > 0 && leased > 0? 0: 1;
+}
\ No newline at end of file
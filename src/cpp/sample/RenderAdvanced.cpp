@@ -40,30 +40,27 @@ NextSample()
   return sinf(2.0f * _phase * static_cast<float>(M_PI));
 }
 
+// Typed views: sample type and layout are fixed at compile time.
 static uint32_t 
-OnInterleavedBuffer(Xt::Stream const& stream, Xt::Buffer const& buffer, void* user)
+OnInterleavedBuffer(Xt::Stream const& stream, Xt::BufferView<float, Xt::Layout::Interleaved> const& buffer)
 {
-  float* output = static_cast<float*>(buffer.output);
-  int32_t channels = stream.GetFormat().channels.outputs;
-  int32_t size = Xt::Audio::GetSampleAttributes(Mix.sample).size;
+  auto const& output = buffer.output;
   for(int32_t f = 0; f < buffer.frames; f++) 
   {
     float sample = NextSample();
-    for (int32_t c = 0; c < channels; c++) output[f * channels + c] = sample;
+    for (int32_t c = 0; c < output.Channels(); c++) output(f, c) = sample;
   }
   return 0;
 }
 
 static uint32_t 
-OnNonInterleavedBuffer(Xt::Stream const& stream, Xt::Buffer const& buffer, void* user) 
+OnNonInterleavedBuffer(Xt::Stream const& stream, Xt::BufferView<float, Xt::Layout::NonInterleaved> const& buffer) 
 {
-  float** output = static_cast<float**>(buffer.output);
-  int32_t channels = stream.GetFormat().channels.outputs;
-  int32_t size = Xt::Audio::GetSampleAttributes(Mix.sample).size;
+  auto const& output = buffer.output;
   for(int32_t f = 0; f < buffer.frames; f++) 
   {
     float sample = NextSample();
-    for(int32_t c = 0; c < channels; c++) output[c][f] = sample;
+    for(int32_t c = 0; c < output.Channels(); c++) output(f, c) = sample;
   }
   return 0;
 }
@@ -84,36 +81,36 @@ RenderAdvancedMain()
   Xt::BufferSize size = device->GetBufferSize(format);
 
   std::cout << "Render interleaved...\n";
-  Xt::StreamParams streamParams(true, OnInterleavedBuffer, OnXRun, OnRunning);
+  Xt::StreamParams streamParams(true, nullptr, OnXRun, OnRunning);
   Xt::DeviceStreamParams deviceParams(streamParams, format, size.current);
   {
-    std::unique_ptr<Xt::Stream> stream = device->OpenStream(deviceParams, nullptr);
+    std::unique_ptr<Xt::Stream> stream = device->OpenStream<float, Xt::Layout::Interleaved>(deviceParams, OnInterleavedBuffer, nullptr);
     RunStream(stream.get());
   }
 
   std::cout << "Render non-interleaved...\n";
-  streamParams = Xt::StreamParams(false, OnNonInterleavedBuffer, OnXRun, OnRunning);
+  streamParams = Xt::StreamParams(false, nullptr, OnXRun, OnRunning);
   deviceParams = Xt::DeviceStreamParams(streamParams, format, size.current);
   {
-    std::unique_ptr<Xt::Stream> stream = device->OpenStream(deviceParams, nullptr);
+    std::unique_ptr<Xt::Stream> stream = device->OpenStream<float, Xt::Layout::NonInterleaved>(deviceParams, OnNonInterleavedBuffer, nullptr);
     RunStream(stream.get());
   }
 
   std::cout << "Render interleaved (channel 0)...\n";
   Xt::Format sendTo0(Mix, Xt::Channels(0, 0, 1, 1ULL << 0));
-  streamParams = Xt::StreamParams(true, OnInterleavedBuffer, OnXRun, OnRunning);
+  streamParams = Xt::StreamParams(true, nullptr, OnXRun, OnRunning);
   deviceParams = Xt::DeviceStreamParams(streamParams, sendTo0, size.current);
   {
-    std::unique_ptr<Xt::Stream> stream = device->OpenStream(deviceParams, nullptr);
+    std::unique_ptr<Xt::Stream> stream = device->OpenStream<float, Xt::Layout::Interleaved>(deviceParams, OnInterleavedBuffer, nullptr);
     RunStream(stream.get());
   }
 
   std::cout << "Render non-interleaved (channel 1)...\n";
   Xt::Format sendTo1(Mix, Xt::Channels(0, 0, 1, 1ULL << 1));
-  streamParams = Xt::StreamParams(false, OnNonInterleavedBuffer, OnXRun, OnRunning);
+  streamParams = Xt::StreamParams(false, nullptr, OnXRun, OnRunning);
   deviceParams = Xt::DeviceStreamParams(streamParams, sendTo1, size.current);
   {
-    std::unique_ptr<Xt::Stream> stream = device->OpenStream(deviceParams, nullptr);
+    std::unique_ptr<Xt::Stream> stream = device->OpenStream<float, Xt::Layout::NonInterleaved>(deviceParams, OnNonInterleavedBuffer, nullptr);
     RunStream(stream.get());
   }
 
@@ -0,0 +1,83 @@
+#include <xt/XtAudio.hpp>
+#include <xt/XtAudioRoundTrip.hpp>
+
+#include <chrono>
+#include <thread>
+#include <memory>
+#include <cstdint>
+#include <iostream>
+
+// Measures the true round-trip latency of the default duplex device, or
+// of the default input and output devices aggregated, and compares it to
+// the estimate reported by the stream. Requires the output to be looped
+// back into the input, e.g. with a cable or ALSA's snd-aloop.
+
+static Xt::Mix const Mix(48000, Xt::Sample::Int16);
+
+static void
+Measure(Xt::Stream& stream, Xt::RoundTrip::Probe& probe)
+{
+  stream.Start();
+  auto timeout = std::chrono::steady_clock::now() + std::chrono::milliseconds(static_cast<int64_t>(probe.GetDuration()) + 5000);
+  while(!probe.IsDone() && stream.IsRunning() && std::chrono::steady_clock::now() < timeout)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  Xt::Latency estimate = stream.GetLatency();
+  stream.Stop();
+
+  Xt::RoundTrip::Result result = probe.Analyze();
+  std::cout << "Estimated latency: " << estimate.input + estimate.output << " ms.\n";
+  std::cout << "Detected " << result.detected << " of " << result.repetitions << " repetitions.\n";
+  if(result.detected == 0) return;
+  std::cout << "Measured latency: " << result.latency << " ms (min " << result.minimum;
+  std::cout << ", max " << result.maximum << ", jitter " << result.jitter << ").\n";
+}
+
+static void
+MeasureDuplex(Xt::Service const& service)
+{
+  Xt::Format format(Mix, Xt::Channels(1, 0, 1, 0));
+  std::optional<std::string> id = service.GetDefaultDeviceId(true);
+  if(!id.has_value()) return;
+  std::unique_ptr<Xt::Device> device = service.OpenDevice(id.value());
+  if(!device->SupportsFormat(format)) return;
+
+  Xt::RoundTrip::Probe probe(format, true);
+  double bufferSize = device->GetBufferSize(format).current;
+  Xt::StreamParams streamParams(true, Xt::RoundTrip::Probe::OnBuffer, nullptr, nullptr);
+  Xt::DeviceStreamParams deviceParams(streamParams, format, bufferSize);
+  std::unique_ptr<Xt::Stream> stream = device->OpenStream(deviceParams, &probe);
+  Measure(*stream, probe);
+}
+
+static void
+MeasureAggregate(Xt::Service& service)
+{
+  std::optional<std::string> inputId = service.GetDefaultDeviceId(false);
+  std::optional<std::string> outputId = service.GetDefaultDeviceId(true);
+  if(!inputId.has_value() || !outputId.has_value()) return;
+  std::unique_ptr<Xt::Device> input = service.OpenDevice(inputId.value());
+  std::unique_ptr<Xt::Device> output = service.OpenDevice(outputId.value());
+  if(!input->SupportsFormat(Xt::Format(Mix, Xt::Channels(1, 0, 0, 0)))) return;
+  if(!output->SupportsFormat(Xt::Format(Mix, Xt::Channels(0, 0, 1, 0)))) return;
+
+  Xt::AggregateDeviceParams deviceParams[2];
+  deviceParams[0] = Xt::AggregateDeviceParams(input.get(), Xt::Channels(1, 0, 0, 0), 10.0);
+  deviceParams[1] = Xt::AggregateDeviceParams(output.get(), Xt::Channels(0, 0, 1, 0), 10.0);
+  Xt::RoundTrip::Probe probe(Xt::Format(Mix, Xt::Channels(1, 0, 1, 0)), true);
+  Xt::StreamParams streamParams(true, Xt::RoundTrip::Probe::OnBuffer, nullptr, nullptr);
+  Xt::AggregateStreamParams aggregateParams(streamParams, deviceParams, 2, Mix, output.get());
+  std::unique_ptr<Xt::Stream> stream = service.AggregateStream(aggregateParams, &probe);
+  Measure(*stream, probe);
+}
+
+int
+RoundTripMain()
+{
+  std::unique_ptr<Xt::Platform> platform = Xt::Audio::Init("", nullptr);
+  Xt::System system = platform->SetupToSystem(Xt::Setup::ProAudio);
+  std::unique_ptr<Xt::Service> service = platform->GetService(system);
+  if(!service) return 0;
+  if((service->GetCapabilities() & Xt::ServiceCapsFullDuplex) != 0) MeasureDuplex(*service);
+  else if((service->GetCapabilities() & Xt::ServiceCapsAggregation) != 0) MeasureAggregate(*service);
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include <xt/XtAudio.hpp>
+
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+// Drives native, emulated and aggregate streams over the file backend
+// and reports real-time violations (allocations and lock acquisitions
+// on the audio thread outside of the user callback). Violations are
+// only counted when the library is built with XT_ENABLE_RT_CHECK=1.
+// Returns nonzero if any violation was counted or any stream failed to
+// run, so it can be used as a test.
+
+static int32_t const Cycles = 2000;
+static char const* const Path = "xt-rtcheck.wav";
+static char const* const CopyPath = "xt-rtcheck-copy.wav";
+static Xt::Mix const Mix(48000, Xt::Sample::Float32);
+
+static uint32_t
+OnBuffer(Xt::Stream const& stream, Xt::Buffer const& buffer, void* user)
+{
+  Xt::Format const& format = stream.GetFormat();
+  static_cast<std::atomic<int32_t>*>(user)->fetch_add(1);
+  if(buffer.output == nullptr) return 0;
+  if(buffer.input != nullptr && format.channels.inputs == format.channels.outputs)
+  {
+    std::memcpy(buffer.output, buffer.input, buffer.frames * format.channels.outputs * sizeof(float));
+    return 0;
+  }
+  for(int32_t c = 0; c < format.channels.outputs; c++)
+  {
+    float* channel = static_cast<float**>(buffer.output)[c];
+    for(int32_t f = 0; f < buffer.frames; f++) channel[f] = 0.25f;
+  }
+  return 0;
+}
+
+static uint32_t
+OnInterleavedBuffer(Xt::Stream const& stream, Xt::Buffer const& buffer, void* user)
+{
+  Xt::Format const& format = stream.GetFormat();
+  static_cast<std::atomic<int32_t>*>(user)->fetch_add(1);
+  if(buffer.output == nullptr) return 0;
+  if(buffer.input != nullptr) std::memcpy(buffer.output, buffer.input, buffer.frames * format.channels.outputs * sizeof(float));
+  else for(int32_t s = 0; s < buffer.frames * format.channels.outputs; s++) static_cast<float*>(buffer.output)[s] = 0.25f;
+  return 0;
+}
+
+static bool
+Run(char const* name, Xt::Stream& stream, std::atomic<int32_t>& cycles)
+{
+  uint64_t before = Xt::Audio::GetRtViolations();
+  stream.SetFreewheel(true);
+  stream.Start();
+  while(cycles.load() < Cycles && stream.IsRunning())
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  stream.Stop();
+  uint64_t violations = Xt::Audio::GetRtViolations() - before;
+  std::cout << name << ": " << cycles.load() << " cycles, " << violations << " violations.\n";
+  return cycles.load() > 0 && violations == 0;
+}
+
+static bool
+RunDevice(char const* name, Xt::Service const& service, std::string const& id, Xt::Channels const& channels, bool interleaved, double bufferSize)
+{
+  std::atomic<int32_t> cycles(0);
+  auto onBuffer = interleaved? OnInterleavedBuffer: OnBuffer;
+  std::unique_ptr<Xt::Device> device = service.OpenDevice(id);
+  Xt::StreamParams streamParams(interleaved, onBuffer, nullptr, nullptr);
+  Xt::DeviceStreamParams deviceParams(streamParams, Xt::Format(Mix, channels), bufferSize);
+  std::unique_ptr<Xt::Stream> stream = device->OpenStream(deviceParams, &cycles);
+  return Run(name, *stream, cycles);
+}
+
+static bool
+RunAggregate(Xt::Service& service, std::string const& inputId, std::string const& outputId)
+{
+  std::atomic<int32_t> cycles(0);
+  std::unique_ptr<Xt::Device> input = service.OpenDevice(inputId);
+  std::unique_ptr<Xt::Device> output = service.OpenDevice(outputId);
+  Xt::AggregateDeviceParams deviceParams[2];
+  deviceParams[0] = Xt::AggregateDeviceParams(input.get(), Xt::Channels(2, 0, 0, 0), 1.0);
+  deviceParams[1] = Xt::AggregateDeviceParams(output.get(), Xt::Channels(0, 0, 2, 0), 1.0);
+  Xt::StreamParams streamParams(true, OnInterleavedBuffer, nullptr, nullptr);
+  Xt::AggregateStreamParams aggregateParams(streamParams, deviceParams, 2, Mix, output.get());
+  std::unique_ptr<Xt::Stream> stream = service.AggregateStream(aggregateParams, &cycles);
+  return Run("Aggregate", *stream, cycles);
+}
+
+int
+RtCheckMain()
+{
+  std::string input = std::string(Path) + ",TYPE=0";
+  std::string output = std::string(Path) + ",TYPE=1";
+  std::string copy = std::string(CopyPath) + ",TYPE=1";
+  std::unique_ptr<Xt::Platform> platform = Xt::Audio::Init("", nullptr);
+  std::unique_ptr<Xt::Service> service = platform->GetService(Xt::System::File);
+  if(!service) return std::cout << "File service not available.\n", 1;
+
+  bool ok = true;
+  ok &= RunDevice("Native output", *service, output, Xt::Channels(0, 0, 2, 0), true, 10.0);
+  ok &= RunDevice("Native input", *service, input, Xt::Channels(2, 0, 0, 0), true, 10.0);
+  ok &= RunDevice("Emulated input", *service, input, Xt::Channels(2, 0, 0, 0), false, 10.0);
+  ok &= RunDevice("Emulated output", *service, copy, Xt::Channels(0, 0, 2, 0), false, 10.0);
+  ok &= RunAggregate(*service, input, copy);
+  std::cout << "Total violations: " << Xt::Audio::GetRtViolations() << ".\n";
+  std::remove(Path);
+  std::remove(CopyPath);
+  return ok? 0: 1;
+}
\ No newline at end of file
@@ -3,6 +3,9 @@
 #include <cstdlib>
 #include <iostream>
 
+extern int GraphMain();
+extern int RtCheckMain();
+extern int RoundTripMain();
 extern int AggregateMain();
 extern int FullDuplexMain();
 extern int PrintSimpleMain();
@@ -16,20 +19,22 @@ static char const*
 Names[] =
 {
   "PrintSimple", "PrintDetailed", "CaptureSimple", "RenderSimple",
-  "CaptureAdvanced", "RenderAdvanced", "FullDuplex", "Aggregate"
+  "CaptureAdvanced", "RenderAdvanced", "FullDuplex", "Aggregate",
+  "RtCheck", "RoundTrip", "Graph"
 };
 
 static int(*Samples[])() = 
 {
   PrintSimpleMain, PrintDetailedMain, CaptureSimpleMain, RenderSimpleMain,
   CaptureAdvancedMain, RenderAdvancedMain, FullDuplexMain, AggregateMain, 
+  RtCheckMain, RoundTripMain, GraphMain
 };
 
-static void 
+static int 
 RunSample(int32_t index)
 {
   std::cout << Names[index] << ":\n";
-  Samples[index]();
+  return Samples[index]();
 }
 
 int 
@@ -38,9 +43,10 @@ main(int argc, char** argv)
   int32_t index = argc == 2? std::stoi(std::string(argv[1])): -1;
   try
   {
-    if (index >= 0) RunSample(index);
-    else for (int32_t i = 0; i < sizeof(Samples)/sizeof(Samples[0]); i++) RunSample(i);
-    return EXIT_SUCCESS;
+    int result = 0;
+    if (index >= 0) result = RunSample(index);
+    else for (int32_t i = 0; i < sizeof(Samples)/sizeof(Samples[0]); i++) result |= RunSample(i);
+    return result == 0? EXIT_SUCCESS: EXIT_FAILURE;
   } catch (Xt::Exception const& e)
   { 
     std::cout << Xt::Audio::GetErrorInfo(e.GetError()) << "\n"; 
@@ -0,0 +1,119 @@
+#include <xt/XtAudio.hpp>
+#include <xt/XtAudioAsync.hpp>
+
+#include <cmath>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <memory>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+
+// Drives the file backend from a coroutine: renders a short sine to a
+// file, then reads it back in blocks through a ring-backed input stream.
+// Built separately since XtAudioAsync.hpp requires C++20.
+
+static int32_t const BlockFrames = 512;
+static char const* const Path = "xt-async.wav";
+static Xt::Mix const Mix(48000, Xt::Sample::Float32);
+static Xt::Format const OutputFormat(Mix, Xt::Channels(0, 0, 2, 0));
+static Xt::Format const InputFormat(Mix, Xt::Channels(2, 0, 0, 0));
+
+// Fire-and-forget coroutine, completion is reported by the body.
+struct Task
+{
+  struct promise_type
+  {
+    Task get_return_object() { return {}; }
+    void return_void() { }
+    void unhandled_exception() { std::terminate(); }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+  };
+};
+
+static uint32_t
+OnBuffer(Xt::Stream const& stream, Xt::Buffer const& buffer, void* user)
+{
+  auto phase = static_cast<double*>(user);
+  float* output = static_cast<float*>(buffer.output);
+  for(int32_t f = 0; f < buffer.frames; f++)
+  {
+    *phase += 440.0 / Mix.rate;
+    output[f * 2] = output[f * 2 + 1] = static_cast<float>(std::sin(*phase * 2.0 * 3.14159265358979));
+  }
+  return 0;
+}
+
+// Renders on the control thread, the coroutine is resumed there.
+static Xt::Async::Operation<void>
+Render(Xt::Async::Control& control, Xt::Service const& service, double& phase)
+{
+  return control.Invoke([&service, &phase] {
+    std::unique_ptr<Xt::Device> device = service.OpenDevice(std::string(Path) + ",TYPE=1");
+    Xt::StreamParams streamParams(true, OnBuffer, nullptr, nullptr);
+    Xt::DeviceStreamParams deviceParams(streamParams, OutputFormat, 10.0);
+    std::unique_ptr<Xt::Stream> stream = device->OpenStream(deviceParams, &phase);
+    stream->Start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    stream->Stop(); });
+}
+
+// Without a resume hook, the coroutine continues on the reader's thread
+// after each block and destroys the reader there.
+static Task
+Capture(Xt::Async::Control& control, std::promise<int64_t>& done)
+{
+  try
+  {
+    double phase = 0.0;
+    int64_t frames = 0;
+    std::unique_ptr<Xt::Service> service = co_await control.Invoke([&control] {
+      return control.GetPlatform().GetService(Xt::System::File); });
+    if(!service) throw std::runtime_error("File service not available.");
+    co_await Render(control, *service, phase);
+    std::unique_ptr<Xt::Device> device = co_await control.OpenDevice(*service, std::string(Path) + ",TYPE=0");
+    Xt::StreamParams streamParams(true, nullptr, nullptr, nullptr);
+    Xt::DeviceStreamParams deviceParams(streamParams, InputFormat, 10.0);
+    std::unique_ptr<Xt::Stream> stream = co_await control.OpenStream(*device, deviceParams, nullptr);
+    co_await control.Invoke([&stream] { stream->InitRings(BlockFrames * 8, 0); });
+    co_await control.Start(*stream);
+    auto reader = std::make_unique<Xt::Async::Reader<float, Xt::Layout::Interleaved>>(control, *stream, BlockFrames);
+    while(auto block = co_await reader->Next()) frames += block->Frames();
+    reader.reset();
+    co_await control.Stop(*stream);
+    co_await control.Close(std::move(stream));
+    co_await control.Close(std::move(device));
+    done.set_value(frames);
+  } catch(...)
+  {
+    done.set_exception(std::current_exception());
+  }
+}
+
+int
+main()
+{
+  try
+  {
+    Xt::Async::Control control("", nullptr);
+    std::promise<int64_t> captured;
+    Capture(control, captured);
+    int64_t frames = captured.get_future().get();
+    std::cout << "Captured " << frames << " frames in blocks of " << BlockFrames << ".\n";
+    std::remove(Path);
+    return frames > 0? EXIT_SUCCESS: EXIT_FAILURE;
+  } catch(Xt::Exception const& e)
+  {
+    std::cout << Xt::Audio::GetErrorInfo(e.GetError()) << "\n";
+    return EXIT_FAILURE;
+  } catch(std::exception const& e)
+  {
+    std::cout << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
\ No newline at end of file
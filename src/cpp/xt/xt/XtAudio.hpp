@@ -6,6 +6,7 @@
 #include <xt/api/Enums.hpp>
 #include <xt/api/Structs.hpp>
 #include <xt/api/Callbacks.hpp>
+#include <xt/api/BufferView.hpp>
 
 #include <xt/api/XtAudio.hpp>
 #include <xt/api/XtPrint.hpp>
@@ -0,0 +1,325 @@
+#ifndef XT_AUDIO_ASYNC_HPP
+#define XT_AUDIO_ASYNC_HPP
+
+/** @file */
+/** @cond */
+#include <xt/XtAudio.hpp>
+
+#if !defined(__cpp_impl_coroutine)
+#error "XtAudioAsync.hpp requires C++20 coroutines."
+#endif
+
+#include <mutex>
+#include <deque>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <utility>
+#include <optional>
+#include <exception>
+#include <coroutine>
+#include <functional>
+#include <type_traits>
+#include <condition_variable>
+/** @endcond */
+
+namespace Xt::Async {
+
+// Runs a function on the control thread and resumes the awaiting
+// coroutine there (or through the control's resume hook) on completion.
+template <class T>
+class Operation final
+{
+  std::function<T()> _run;
+  class Control* _control;
+  std::exception_ptr _error;
+  std::optional<std::conditional_t<std::is_void_v<T>, bool, T>> _result;
+public:
+  Operation(Control* control, std::function<T()> run):
+  _run(std::move(run)), _control(control) { }
+
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> handle);
+  T await_resume();
+};
+
+// Owns the thread XT-Audio considers the main thread. All device and
+// stream control runs there, so coroutines driving many streams never
+// block their own threads on Start/Stop/Open. A coroutine resumed on
+// the control thread may destroy the control, operations still queued
+// at that point never complete.
+class Control final
+{
+  bool _closing;
+  bool* _destroyed;
+  std::mutex _lock;
+  std::thread _thread;
+  std::exception_ptr _error;
+  std::condition_variable _signal;
+  std::unique_ptr<Platform> _platform;
+  std::deque<std::function<void()>> _queue;
+  std::function<void(std::coroutine_handle<>)> _resume;
+
+  void Run(std::string id, void* window);
+public:
+  ~Control();
+  Control(std::string const& id, void* window, std::function<void(std::coroutine_handle<>)> resume = nullptr);
+
+  void Post(std::function<void()> work);
+  void Resume(std::coroutine_handle<> handle);
+  Platform& GetPlatform() const { return *_platform; }
+
+  template <class F>
+  auto Invoke(F f) -> Operation<std::invoke_result_t<F>>
+  { return Operation<std::invoke_result_t<F>>(this, std::move(f)); }
+
+  Operation<void> Stop(Stream& stream) { return Invoke([&stream] { stream.Stop(); }); }
+  Operation<void> Start(Stream& stream) { return Invoke([&stream] { stream.Start(); }); }
+  template <class T>
+  Operation<void> Close(std::unique_ptr<T> object)
+  { return Invoke([o = std::shared_ptr<T>(std::move(object))]() mutable { o.reset(); }); }
+  Operation<std::unique_ptr<Device>> OpenDevice(Service const& service, std::string const& id)
+  { return Invoke([&service, id] { return service.OpenDevice(id); }); }
+  Operation<std::unique_ptr<Stream>> OpenStream(Device& device, DeviceStreamParams const& params, void* user)
+  { return Invoke([&device, params, user] { return device.OpenStream(params, user); }); }
+};
+
+// Pulls fixed-size input blocks from a stream opened without a buffer
+// callback (see Stream::InitRings). The reader's own thread polls the
+// input ring and resumes the awaiting coroutine (through the control)
+// when a block is complete. A shorter block holds what was left when
+// the stream stopped, an empty result means it has stopped. Blocks stay
+// valid until the next call to Next(). Destroy readers before their
+// control. A Next() still pending then completes with an empty result.
+template <class T, Layout L>
+class Reader final
+{
+public:
+  class Awaiter;
+private:
+  int32_t _frames;
+  int32_t _channels;
+  Control* _control;
+  Stream* _stream;
+
+  bool _closing;
+  bool* _destroyed;
+  std::mutex _lock;
+  std::thread _thread;
+  Awaiter* _waiting;
+  std::vector<T> _data;
+  std::vector<T*> _cursor;
+  std::vector<T*> _channelData;
+  std::condition_variable _signal;
+  static inline int32_t const PollMs = 2;
+
+  void Run();
+  void* Cursor(int32_t offset);
+public:
+  class Awaiter final
+  {
+    friend class Reader;
+    Reader* _reader;
+    std::coroutine_handle<> _handle;
+    std::optional<SampleView<T const, L>> _block;
+  public:
+    Awaiter(Reader* reader): _reader(reader) { }
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle);
+    std::optional<SampleView<T const, L>> await_resume() { return _block; }
+  };
+
+  ~Reader();
+  Reader(Control& control, Stream& stream, int32_t frames);
+  Awaiter Next() { return Awaiter(this); }
+};
+
+template <class T>
+inline void
+Operation<T>::await_suspend(std::coroutine_handle<> handle)
+{
+  _control->Post([this, handle] {
+    try
+    {
+      if constexpr(std::is_void_v<T>) _run(), _result.emplace(true);
+      else _result.emplace(_run());
+    } catch(...)
+    {
+      _error = std::current_exception();
+    }
+    _control->Resume(handle);
+  });
+}
+
+template <class T>
+inline T
+Operation<T>::await_resume()
+{
+  if(_error) std::rethrow_exception(_error);
+  if constexpr(!std::is_void_v<T>) return std::move(*_result);
+}
+
+inline
+Control::Control(std::string const& id, void* window, std::function<void(std::coroutine_handle<>)> resume):
+_closing(false), _destroyed(nullptr), _resume(std::move(resume))
+{
+  std::unique_lock<std::mutex> lock(_lock);
+  _thread = std::thread(&Control::Run, this, id, window);
+  _signal.wait(lock, [this] { return _platform != nullptr || _error; });
+  if(!_error) return;
+  lock.unlock();
+  _thread.join();
+  std::rethrow_exception(_error);
+}
+
+// Destroyed from the control thread itself, the platform is released
+// right here and the thread exits once the current work item returns.
+inline
+Control::~Control()
+{
+  if(std::this_thread::get_id() == _thread.get_id())
+  {
+    *_destroyed = true;
+    _thread.detach();
+    return;
+  }
+  Post([this] { _platform.reset(); _closing = true; });
+  _thread.join();
+}
+
+inline void
+Control::Resume(std::coroutine_handle<> handle)
+{
+  if(_resume) _resume(handle);
+  else handle.resume();
+}
+
+inline void
+Control::Post(std::function<void()> work)
+{
+  std::lock_guard<std::mutex> lock(_lock);
+  _queue.push_back(std::move(work));
+  _signal.notify_all();
+}
+
+inline void
+Control::Run(std::string id, void* window)
+{
+  {
+    std::lock_guard<std::mutex> lock(_lock);
+    try { _platform = Audio::Init(id, window); }
+    catch(...) { _error = std::current_exception(); }
+    _signal.notify_all();
+    if(_error) return;
+  }
+  bool destroyed = false;
+  _destroyed = &destroyed;
+  while(!_closing)
+  {
+    std::function<void()> work;
+    {
+      std::unique_lock<std::mutex> lock(_lock);
+      _signal.wait(lock, [this] { return !_queue.empty(); });
+      work = std::move(_queue.front());
+      _queue.pop_front();
+    }
+    work();
+    if(destroyed) return;
+  }
+}
+
+template <class T, Layout L>
+inline
+Reader<T, L>::Reader(Control& control, Stream& stream, int32_t frames):
+_frames(frames), _channels(stream.GetFormat().channels.inputs),
+_control(&control), _stream(&stream), _closing(false), _destroyed(nullptr), _waiting(nullptr)
+{
+  _data.resize(static_cast<size_t>(_frames * _channels));
+  _cursor.resize(static_cast<size_t>(_channels));
+  for(int32_t c = 0; c < _channels; c++) _channelData.push_back(_data.data() + c * _frames);
+  _thread = std::thread(&Reader::Run, this);
+}
+
+// Without a resume hook the coroutine runs on the reader's thread, and
+// destroying the reader from there detaches the thread instead.
+template <class T, Layout L>
+inline
+Reader<T, L>::~Reader()
+{
+  if(std::this_thread::get_id() == _thread.get_id())
+  {
+    *_destroyed = true;
+    _thread.detach();
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(_lock);
+    _closing = true;
+    _signal.notify_all();
+  }
+  _thread.join();
+}
+
+template <class T, Layout L>
+inline void
+Reader<T, L>::Awaiter::await_suspend(std::coroutine_handle<> handle)
+{
+  _handle = handle;
+  std::lock_guard<std::mutex> lock(_reader->_lock);
+  _reader->_waiting = this;
+  _reader->_signal.notify_all();
+}
+
+template <class T, Layout L>
+inline void*
+Reader<T, L>::Cursor(int32_t offset)
+{
+  if constexpr(L == Layout::Interleaved) return _data.data() + offset * _channels;
+  for(int32_t c = 0; c < _channels; c++) _cursor[c] = _channelData[c] + offset;
+  return _cursor.data();
+}
+
+// Reads never block, so closing is not held up by a stream that has
+// stopped delivering. The stream is checked before reading, so audio
+// arriving just before it stops still ends up in the last block.
+template <class T, Layout L>
+inline void
+Reader<T, L>::Run()
+{
+  bool destroyed = false;
+  std::unique_lock<std::mutex> lock(_lock);
+  _destroyed = &destroyed;
+  while(true)
+  {
+    _signal.wait(lock, [this] { return _closing || _waiting != nullptr; });
+    int32_t filled = 0;
+    bool running = true;
+    while(!_closing && running && filled < _frames)
+    {
+      lock.unlock();
+      running = _stream->IsRunning();
+      int32_t read = _stream->Read(Cursor(filled), _frames - filled, 0);
+      filled += read;
+      lock.lock();
+      if(read == 0 && running)
+        _signal.wait_for(lock, std::chrono::milliseconds(PollMs), [this] { return _closing; });
+    }
+    if(_closing) break;
+    Awaiter* awaiter = std::exchange(_waiting, nullptr);
+    std::coroutine_handle<> handle = awaiter->_handle;
+    if(filled > 0) awaiter->_block.emplace(Cursor(0), filled, _channels);
+    lock.unlock();
+    _control->Resume(handle);
+    if(destroyed) return;
+    lock.lock();
+  }
+  if(_waiting == nullptr) return;
+  Control* control = _control;
+  std::coroutine_handle<> handle = std::exchange(_waiting, nullptr)->_handle;
+  control->Post([control, handle] { control->Resume(handle); });
+}
+
+} // namespace Xt::Async
+#endif // XT_AUDIO_ASYNC_HPP
\ No newline at end of file
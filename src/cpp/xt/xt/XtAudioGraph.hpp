@@ -0,0 +1,415 @@
+#ifndef XT_AUDIO_GRAPH_HPP
+#define XT_AUDIO_GRAPH_HPP
+
+/** @file */
+/** @cond */
+#include <xt/XtAudio.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <stdexcept>
+#include <functional>
+/** @endcond */
+
+namespace Xt::Graph {
+
+inline int32_t constexpr SpinCount = 4096;
+inline int32_t constexpr IdleSleepUs = 250;
+
+class Graph;
+
+// What a node sees while processing one period. Inputs are the outputs
+// of the nodes connected to it, in connection order. All buffers are
+// non-interleaved float.
+class Context final
+{
+  int32_t _node;
+  Graph const* _graph;
+public:
+  Context(Graph const* graph, int32_t node): _node(node), _graph(graph) { }
+
+  int32_t Frames() const;
+  int32_t Inputs() const;
+  SampleView<float, Layout::NonInterleaved> Output() const;
+  SampleView<float const, Layout::NonInterleaved> Input(int32_t index) const;
+};
+
+class Node
+{
+public:
+  virtual ~Node() = default;
+  virtual void Process(Context const& context) = 0;
+};
+
+// Chase-Lev deque on a fixed ring: the owning thread pushes and pops at
+// the bottom, any other thread steals from the top. Each node is queued
+// at most once per period, so the ring never needs to grow and indices
+// never need to be reset.
+class Deque final
+{
+  int64_t _mask;
+  std::atomic<int64_t> _top;
+  std::atomic<int64_t> _bottom;
+  std::unique_ptr<std::atomic<int32_t>[]> _items;
+public:
+  Deque(int32_t capacity);
+
+  int32_t Pop();
+  int32_t Steal();
+  void Push(int32_t node);
+};
+
+// Runs a node graph inside a buffer callback. Nodes are scheduled per
+// period in dependency order: the callback thread and a fixed set of
+// worker threads pop ready nodes from their own deque and steal from
+// the others when empty. Finishing a node releases its successors once
+// their dependency counters reach zero. Nothing on the processing path
+// allocates or locks. Idle workers spin, then yield, then park in short
+// sleeps, so a stopped stream does not keep cores busy; the callback
+// thread always takes part and never waits for a parked worker to wake
+// up unless that worker holds a node.
+//
+// Build the graph and call Prepare() on the main thread while the
+// stream is stopped, then call Process() from the stream's buffer
+// callback. The stream must be opened with float samples and
+// non-interleaved buffers. Input is a pseudo-node exposing the stream's
+// input channels, the node passed to SetOutput() renders directly into
+// the stream's output. Without an output node the output is silent.
+// Node buffers hold at most the maxFrames passed to Prepare(), larger
+// buffers are processed as consecutive periods of at most that size.
+// When a reconfigure (for example a resize) changes the buffer size,
+// stop the stream and call Prepare() again with the new maximum.
+class Graph final
+{
+  struct Entry
+  {
+    int32_t outputs;
+    int32_t indegree;
+    std::unique_ptr<Node> node;
+    std::vector<float> data;
+    std::vector<float*> channels;
+    std::vector<int32_t> sources;
+    std::vector<int32_t> successors;
+    float* const* current;
+  };
+
+  template <class F>
+  class FunctionNode final: public Node
+  {
+    F _process;
+  public:
+    FunctionNode(F process): _process(std::move(process)) { }
+    void Process(Context const& context) override { _process(context); }
+  };
+
+  int32_t _output;
+  int32_t _frames;
+  int32_t _maxFrames;
+  int32_t _threads;
+  int32_t _inputs;
+  int32_t _outputs;
+  float const* const* _input;
+  std::vector<float*> _chunkOutput;
+  std::vector<float const*> _chunkInput;
+  std::vector<Entry> _entries;
+  std::vector<int32_t> _roots;
+  std::function<void()> _onThreadStart;
+
+  std::atomic_bool _closing;
+  std::atomic<uint64_t> _epoch;
+  std::atomic<int32_t> _remaining;
+  std::vector<std::thread> _workers;
+  std::vector<std::unique_ptr<Deque>> _deques;
+  std::unique_ptr<std::atomic<int32_t>[]> _pending;
+
+  void Stop();
+  void Work(int32_t index);
+  void Run(float const* const* input, float* const* output, int32_t frames);
+  int32_t Steal(int32_t index);
+  void RunNode(int32_t index, int32_t node);
+  void RunWorker(int32_t index);
+  friend class Context;
+public:
+  static int32_t constexpr Input = -1;
+
+  ~Graph();
+  Graph(int32_t threads, std::function<void()> onThreadStart = nullptr);
+
+  void SetOutput(int32_t node);
+  void Connect(int32_t from, int32_t to);
+  int32_t Add(std::unique_ptr<Node> node, int32_t outputs);
+  template <class F>
+  int32_t Add(int32_t outputs, F process)
+  { return Add(std::make_unique<FunctionNode<F>>(std::move(process)), outputs); }
+
+  void Prepare(Stream const& stream);
+  void Prepare(Format const& format, int32_t maxFrames);
+  void Process(Buffer const& buffer);
+  void Process(BufferView<float, Layout::NonInterleaved> const& buffer);
+};
+
+inline int32_t
+Context::Frames() const
+{ return _graph->_frames; }
+
+inline int32_t
+Context::Inputs() const
+{ return static_cast<int32_t>(_graph->_entries[_node].sources.size()); }
+
+inline SampleView<float, Layout::NonInterleaved>
+Context::Output() const
+{
+  auto const& entry = _graph->_entries[_node];
+  return SampleView<float, Layout::NonInterleaved>(const_cast<float**>(entry.current), _graph->_frames, entry.outputs);
+}
+
+inline SampleView<float const, Layout::NonInterleaved>
+Context::Input(int32_t index) const
+{
+  int32_t source = _graph->_entries[_node].sources[index];
+  if(source == Graph::Input)
+    return SampleView<float const, Layout::NonInterleaved>(_graph->_input, _graph->_frames, _graph->_inputs);
+  auto const& entry = _graph->_entries[source];
+  return SampleView<float const, Layout::NonInterleaved>(entry.current, _graph->_frames, entry.outputs);
+}
+
+inline
+Deque::Deque(int32_t capacity):
+_mask(0), _top(0), _bottom(0)
+{
+  int64_t size = 2;
+  while(size < capacity) size *= 2;
+  _mask = size - 1;
+  _items = std::make_unique<std::atomic<int32_t>[]>(static_cast<size_t>(size));
+}
+
+inline void
+Deque::Push(int32_t node)
+{
+  int64_t bottom = _bottom.load(std::memory_order_relaxed);
+  _items[bottom & _mask].store(node, std::memory_order_relaxed);
+  _bottom.store(bottom + 1, std::memory_order_release);
+}
+
+inline int32_t
+Deque::Pop()
+{
+  int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+  _bottom.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t top = _top.load(std::memory_order_relaxed);
+  if(top > bottom) return _bottom.store(bottom + 1, std::memory_order_relaxed), -1;
+  int32_t result = _items[bottom & _mask].load(std::memory_order_relaxed);
+  if(top != bottom) return result;
+  if(!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) result = -1;
+  _bottom.store(bottom + 1, std::memory_order_relaxed);
+  return result;
+}
+
+inline int32_t
+Deque::Steal()
+{
+  int64_t top = _top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t bottom = _bottom.load(std::memory_order_acquire);
+  if(top >= bottom) return -1;
+  int32_t result = _items[top & _mask].load(std::memory_order_relaxed);
+  if(!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return -1;
+  return result;
+}
+
+inline
+Graph::Graph(int32_t threads, std::function<void()> onThreadStart):
+_output(-1), _frames(0), _maxFrames(0), _threads(threads), _inputs(0), _outputs(0), _input(nullptr),
+_onThreadStart(std::move(onThreadStart)), _closing(false), _epoch(0), _remaining(0)
+{ if(threads < 0) throw std::invalid_argument("threads"); }
+
+inline
+Graph::~Graph()
+{ Stop(); }
+
+inline void
+Graph::Stop()
+{
+  _closing.store(true);
+  for(auto& worker: _workers) worker.join();
+  _workers.clear();
+  _closing.store(false);
+}
+
+inline int32_t
+Graph::Add(std::unique_ptr<Node> node, int32_t outputs)
+{
+  if(!node || outputs < 0) throw std::invalid_argument("node");
+  Entry entry = {};
+  entry.outputs = outputs;
+  entry.node = std::move(node);
+  _entries.push_back(std::move(entry));
+  return static_cast<int32_t>(_entries.size() - 1);
+}
+
+inline void
+Graph::Connect(int32_t from, int32_t to)
+{
+  auto count = static_cast<int32_t>(_entries.size());
+  if(from < Input || from >= count || to < 0 || to >= count || from == to) throw std::invalid_argument("node");
+  _entries[to].sources.push_back(from);
+}
+
+inline void
+Graph::SetOutput(int32_t node)
+{
+  if(node < 0 || node >= static_cast<int32_t>(_entries.size())) throw std::invalid_argument("node");
+  _output = node;
+}
+
+inline void
+Graph::Prepare(Stream const& stream)
+{ Prepare(stream.GetFormat(), stream.GetFrames()); }
+
+inline void
+Graph::Prepare(Format const& format, int32_t maxFrames)
+{
+  Stop();
+  auto count = static_cast<int32_t>(_entries.size());
+  if(maxFrames <= 0) throw std::invalid_argument("maxFrames");
+  if(format.mix.sample != Sample::Float32) throw std::invalid_argument("format");
+  if(_output >= 0 && _entries[_output].outputs != format.channels.outputs) throw std::invalid_argument("format");
+
+  _roots.clear();
+  _inputs = format.channels.inputs;
+  _outputs = format.channels.outputs;
+  _maxFrames = maxFrames;
+  _chunkInput.resize(static_cast<size_t>(_inputs));
+  _chunkOutput.resize(static_cast<size_t>(_outputs));
+  for(auto& entry: _entries)
+  {
+    entry.indegree = 0;
+    entry.successors.clear();
+    entry.data.assign(static_cast<size_t>(entry.outputs) * maxFrames, 0.0f);
+    entry.channels.resize(static_cast<size_t>(entry.outputs));
+    for(int32_t c = 0; c < entry.outputs; c++) entry.channels[c] = entry.data.data() + c * maxFrames;
+    entry.current = entry.channels.data();
+  }
+  for(int32_t i = 0; i < count; i++)
+    for(int32_t source: _entries[i].sources)
+      if(source != Input) _entries[source].successors.push_back(i), _entries[i].indegree++;
+
+  std::vector<int32_t> order;
+  std::vector<int32_t> indegrees(static_cast<size_t>(count));
+  for(int32_t i = 0; i < count; i++)
+    if((indegrees[i] = _entries[i].indegree) == 0) order.push_back(i), _roots.push_back(i);
+  for(size_t i = 0; i < order.size(); i++)
+    for(int32_t successor: _entries[order[i]].successors)
+      if(--indegrees[successor] == 0) order.push_back(successor);
+  if(static_cast<int32_t>(order.size()) != count) throw std::logic_error("Graph contains a cycle.");
+
+  _deques.clear();
+  _pending = std::make_unique<std::atomic<int32_t>[]>(static_cast<size_t>(count));
+  for(int32_t i = 0; i <= _threads; i++) _deques.push_back(std::make_unique<Deque>(count));
+  for(int32_t i = 1; i <= _threads; i++) _workers.emplace_back(&Graph::RunWorker, this, i);
+}
+
+inline void
+Graph::Process(BufferView<float, Layout::NonInterleaved> const& buffer)
+{
+  Buffer raw = { 0 };
+  raw.frames = buffer.frames;
+  raw.input = buffer.input.Data();
+  raw.output = const_cast<float**>(buffer.output.Data());
+  Process(raw);
+}
+
+inline void
+Graph::Process(Buffer const& buffer)
+{
+  auto output = static_cast<float* const*>(buffer.output);
+  auto input = static_cast<float const* const*>(buffer.input);
+  if(buffer.frames <= _maxFrames) return Run(input, output, buffer.frames);
+  for(int32_t done = 0; done < buffer.frames; done += _maxFrames)
+  {
+    int32_t frames = buffer.frames - done < _maxFrames? buffer.frames - done: _maxFrames;
+    for(int32_t c = 0; input != nullptr && c < _inputs; c++) _chunkInput[c] = input[c] + done;
+    for(int32_t c = 0; output != nullptr && c < _outputs; c++) _chunkOutput[c] = output[c] + done;
+    Run(input != nullptr? _chunkInput.data(): nullptr, output != nullptr? _chunkOutput.data(): nullptr, frames);
+  }
+}
+
+inline void
+Graph::Run(float const* const* input, float* const* output, int32_t frames)
+{
+  auto count = static_cast<int32_t>(_entries.size());
+  _frames = frames;
+  _input = input;
+  for(int32_t i = 0; i < count; i++)
+  {
+    _entries[i].current = _entries[i].channels.data();
+    _pending[i].store(_entries[i].indegree, std::memory_order_relaxed);
+  }
+  if(_output >= 0 && output != nullptr) _entries[_output].current = output;
+  _remaining.store(count, std::memory_order_relaxed);
+  for(int32_t root: _roots) _deques[0]->Push(root);
+  _epoch.fetch_add(1, std::memory_order_release);
+  Work(0);
+
+  if(output == nullptr || _output >= 0) return;
+  for(int32_t c = 0; c < _outputs; c++) std::memset(output[c], 0, _frames * sizeof(float));
+}
+
+inline int32_t
+Graph::Steal(int32_t index)
+{
+  auto count = static_cast<int32_t>(_deques.size());
+  for(int32_t i = 1; i < count; i++)
+  {
+    int32_t node = _deques[(index + i) % count]->Steal();
+    if(node >= 0) return node;
+  }
+  return -1;
+}
+
+inline void
+Graph::RunNode(int32_t index, int32_t node)
+{
+  _entries[node].node->Process(Context(this, node));
+  for(int32_t successor: _entries[node].successors)
+    if(_pending[successor].fetch_sub(1, std::memory_order_acq_rel) == 1)
+      _deques[index]->Push(successor);
+  _remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+inline void
+Graph::Work(int32_t index)
+{
+  while(_remaining.load(std::memory_order_acquire) > 0)
+  {
+    int32_t node = _deques[index]->Pop();
+    if(node < 0) node = Steal(index);
+    if(node >= 0) RunNode(index, node);
+    else std::this_thread::yield();
+  }
+}
+
+inline void
+Graph::RunWorker(int32_t index)
+{
+  int32_t idle = 0;
+  uint64_t seen = _epoch.load();
+  if(_onThreadStart) _onThreadStart();
+  while(!_closing.load(std::memory_order_acquire))
+  {
+    uint64_t epoch = _epoch.load(std::memory_order_acquire);
+    if(epoch != seen) seen = epoch, idle = 0, Work(index);
+    else if(++idle < SpinCount) std::this_thread::yield();
+    else std::this_thread::sleep_for(std::chrono::microseconds(IdleSleepUs));
+  }
+}
+
+} // namespace Xt::Graph
+#endif // XT_AUDIO_GRAPH_HPP
\ No newline at end of file
@@ -0,0 +1,263 @@
+#ifndef XT_AUDIO_MIXER_HPP
+#define XT_AUDIO_MIXER_HPP
+
+/** @file */
+/** @cond */
+#include <xt/XtAudio.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+/** @endcond */
+
+namespace Xt::Mixing {
+
+// Sample conversion to and from the float mix bus. The loops are kept
+// branch-free and contiguous so the compiler vectorizes them.
+inline void
+ToFloat(Sample sample, void const* source, float* target, int32_t count)
+{
+  switch(sample)
+  {
+  case Sample::UInt8: {
+    auto s = static_cast<uint8_t const*>(source);
+    for(int32_t i = 0; i < count; i++) target[i] = (static_cast<float>(s[i]) - 128.0f) / 128.0f;
+    break; }
+  case Sample::Int16: {
+    auto s = static_cast<int16_t const*>(source);
+    for(int32_t i = 0; i < count; i++) target[i] = static_cast<float>(s[i]) / 32768.0f;
+    break; }
+  case Sample::Int24: {
+    auto s = static_cast<uint8_t const*>(source);
+    for(int32_t i = 0; i < count; i++)
+    {
+      uint32_t bits = static_cast<uint32_t>(s[i * 3]) << 8 | static_cast<uint32_t>(s[i * 3 + 1]) << 16 | static_cast<uint32_t>(s[i * 3 + 2]) << 24;
+      target[i] = static_cast<float>(static_cast<int32_t>(bits) >> 8) / 8388608.0f;
+    }
+    break; }
+  case Sample::Int32: {
+    auto s = static_cast<int32_t const*>(source);
+    for(int32_t i = 0; i < count; i++) target[i] = static_cast<float>(static_cast<double>(s[i]) / 2147483648.0);
+    break; }
+  case Sample::Float32: std::memcpy(target, source, count * sizeof(float)); break;
+  default: throw std::invalid_argument("sample");
+  }
+}
+
+inline void
+FromFloat(Sample sample, float const* source, void* target, int32_t count)
+{
+  switch(sample)
+  {
+  case Sample::UInt8: {
+    auto t = static_cast<uint8_t*>(target);
+    for(int32_t i = 0; i < count; i++) t[i] = static_cast<uint8_t>(std::clamp(source[i], -1.0f, 127.0f / 128.0f) * 128.0f + 128.0f);
+    break; }
+  case Sample::Int16: {
+    auto t = static_cast<int16_t*>(target);
+    for(int32_t i = 0; i < count; i++) t[i] = static_cast<int16_t>(std::clamp(source[i], -1.0f, 32767.0f / 32768.0f) * 32768.0f);
+    break; }
+  case Sample::Int24: {
+    auto t = static_cast<uint8_t*>(target);
+    for(int32_t i = 0; i < count; i++)
+    {
+      auto v = static_cast<int32_t>(std::clamp(source[i], -1.0f, 8388607.0f / 8388608.0f) * 8388608.0f);
+      t[i * 3] = static_cast<uint8_t>(v);
+      t[i * 3 + 1] = static_cast<uint8_t>(v >> 8);
+      t[i * 3 + 2] = static_cast<uint8_t>(v >> 16);
+    }
+    break; }
+  case Sample::Int32: {
+    auto t = static_cast<int32_t*>(target);
+    for(int32_t i = 0; i < count; i++) t[i] = static_cast<int32_t>(std::clamp(static_cast<double>(source[i]), -1.0, 2147483647.0 / 2147483648.0) * 2147483648.0);
+    break; }
+  case Sample::Float32: std::memcpy(target, source, count * sizeof(float)); break;
+  default: throw std::invalid_argument("sample");
+  }
+}
+
+// One independent source. Any single thread may Write() interleaved
+// frames in the voice's own sample format; they are converted to float
+// into a lock-free single producer, single consumer queue which the
+// mixer drains on the audio thread. Voices run at the mixer's rate.
+class Voice final
+{
+  Sample _sample;
+  int32_t _frames;
+  int32_t _channels;
+  std::vector<float> _queue;
+  std::atomic<float> _gain;
+  std::atomic<uint64_t> _read;
+  std::atomic<uint64_t> _written;
+  std::atomic<uint64_t> _underruns;
+
+  void Accumulate(float* mix, float const* source, int32_t frames, int32_t channels, float gain) const;
+public:
+  Voice(int32_t channels, Sample sample, int32_t frames);
+
+  Sample GetSample() const { return _sample; }
+  int32_t GetChannels() const { return _channels; }
+  float GetGain() const { return _gain.load(); }
+  void SetGain(float gain) { _gain.store(gain); }
+  uint64_t GetUnderruns() const { return _underruns.load(); }
+  int32_t GetFree() const { return _frames - static_cast<int32_t>(_written.load() - _read.load()); }
+
+  int32_t Write(void const* data, int32_t frames);
+  void Mix(float* mix, int32_t frames, int32_t channels);
+};
+
+// Owns a single output stream and mixes any number of voices into it,
+// so adding a source does not mean opening another stream (exclusive
+// devices accept only one). Voices are added and removed on the main
+// thread while the stream runs; the audio thread sees a fixed table of
+// slots and never allocates or locks. The stream is always opened
+// interleaved: params.stream.onBuffer and interleaved are ignored and
+// the remaining callbacks receive the mixer as user data. The mix bus
+// is sized from the buffer size at open, a larger buffer after a resize
+// or reconfigure is mixed in consecutive chunks of at most that size.
+class Mixer final
+{
+  int32_t _maxVoices;
+  Format _format;
+  std::vector<float> _mix;
+  std::atomic<uint64_t> _cycles;
+  std::vector<std::unique_ptr<Voice>> _voices;
+  std::unique_ptr<std::atomic<Voice*>[]> _slots;
+  std::unique_ptr<Stream> _stream;
+
+  static uint32_t
+  OnBuffer(Stream const& stream, Buffer const& buffer, void* user);
+public:
+  Mixer(Device& device, DeviceStreamParams const& params, int32_t maxVoices);
+
+  Stream& GetStream() const { return *_stream; }
+  Format const& GetFormat() const { return _format; }
+
+  void RemoveVoice(Voice* voice);
+  Voice* AddVoice(int32_t channels, Sample sample, int32_t frames);
+};
+
+inline
+Voice::Voice(int32_t channels, Sample sample, int32_t frames):
+_sample(sample), _frames(frames), _channels(channels),
+_gain(1.0f), _read(0), _written(0), _underruns(0)
+{
+  if(channels <= 0 || frames <= 0) throw std::invalid_argument("voice");
+  _queue.resize(static_cast<size_t>(frames) * channels);
+}
+
+inline int32_t
+Voice::Write(void const* data, int32_t frames)
+{
+  uint64_t written = _written.load(std::memory_order_relaxed);
+  int32_t sampleSize = Audio::GetSampleAttributes(_sample).size;
+  int32_t count = std::min(frames, GetFree());
+  auto position = static_cast<int32_t>(written % _frames);
+  int32_t first = std::min(count, _frames - position);
+  ToFloat(_sample, data, _queue.data() + position * _channels, first * _channels);
+  ToFloat(_sample, static_cast<uint8_t const*>(data) + first * _channels * sampleSize, _queue.data(), (count - first) * _channels);
+  _written.store(written + count, std::memory_order_release);
+  return count;
+}
+
+inline void
+Voice::Accumulate(float* mix, float const* source, int32_t frames, int32_t channels, float gain) const
+{
+  if(_channels == channels)
+    for(int32_t i = 0; i < frames * channels; i++) mix[i] += gain * source[i];
+  else if(_channels == 1)
+    for(int32_t f = 0; f < frames; f++)
+      for(int32_t c = 0; c < channels; c++) mix[f * channels + c] += gain * source[f];
+  else
+    for(int32_t f = 0; f < frames; f++)
+      for(int32_t c = 0; c < _channels; c++) mix[f * channels + c % channels] += gain * source[f * _channels + c];
+}
+
+inline void
+Voice::Mix(float* mix, int32_t frames, int32_t channels)
+{
+  float gain = _gain.load(std::memory_order_relaxed);
+  uint64_t read = _read.load(std::memory_order_relaxed);
+  auto available = static_cast<int32_t>(_written.load(std::memory_order_acquire) - read);
+  int32_t count = std::min(frames, available);
+  auto position = static_cast<int32_t>(read % _frames);
+  int32_t first = std::min(count, _frames - position);
+  Accumulate(mix, _queue.data() + position * _channels, first, channels, gain);
+  Accumulate(mix + first * channels, _queue.data(), count - first, channels, gain);
+  if(count > 0 && count < frames) _underruns.fetch_add(1, std::memory_order_relaxed);
+  _read.store(read + count, std::memory_order_release);
+}
+
+inline
+Mixer::Mixer(Device& device, DeviceStreamParams const& params, int32_t maxVoices):
+_maxVoices(maxVoices), _format(params.format), _cycles(0)
+{
+  if(maxVoices <= 0) throw std::invalid_argument("maxVoices");
+  if(_format.channels.inputs != 0 || _format.channels.outputs <= 0) throw std::invalid_argument("format");
+  _slots = std::make_unique<std::atomic<Voice*>[]>(static_cast<size_t>(maxVoices));
+  for(int32_t i = 0; i < maxVoices; i++) _slots[i].store(nullptr);
+  DeviceStreamParams streamParams = params;
+  streamParams.stream.interleaved = true;
+  streamParams.stream.onBuffer = &Mixer::OnBuffer;
+  _stream = device.OpenStream(streamParams, this);
+  _mix.resize(static_cast<size_t>(_stream->GetFrames()) * _format.channels.outputs);
+}
+
+inline Voice*
+Mixer::AddVoice(int32_t channels, Sample sample, int32_t frames)
+{
+  for(int32_t i = 0; i < _maxVoices; i++)
+  {
+    if(_slots[i].load() != nullptr) continue;
+    _voices.push_back(std::make_unique<Voice>(channels, sample, frames));
+    _slots[i].store(_voices.back().get());
+    return _voices.back().get();
+  }
+  throw std::length_error("Too many voices.");
+}
+
+// Waits until a callback that may still be mixing the voice completes.
+inline void
+Mixer::RemoveVoice(Voice* voice)
+{
+  for(int32_t i = 0; i < _maxVoices; i++)
+    if(_slots[i].load() == voice) _slots[i].store(nullptr);
+  uint64_t cycles = _cycles.load();
+  while(_stream->IsRunning() && _cycles.load() == cycles)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  auto owned = [voice](auto const& v) { return v.get() == voice; };
+  _voices.erase(std::remove_if(_voices.begin(), _voices.end(), owned), _voices.end());
+}
+
+inline uint32_t
+Mixer::OnBuffer(Stream const& stream, Buffer const& buffer, void* user)
+{
+  auto mixer = static_cast<Mixer*>(user);
+  float* mix = mixer->_mix.data();
+  Sample sample = mixer->_format.mix.sample;
+  int32_t channels = mixer->_format.channels.outputs;
+  int32_t maxFrames = static_cast<int32_t>(mixer->_mix.size()) / channels;
+  int32_t frameSize = Audio::GetSampleAttributes(sample).size * channels;
+  for(int32_t done = 0; done < buffer.frames; done += maxFrames)
+  {
+    int32_t frames = std::min(maxFrames, buffer.frames - done);
+    std::fill(mix, mix + frames * channels, 0.0f);
+    for(int32_t i = 0; i < mixer->_maxVoices; i++)
+    {
+      Voice* voice = mixer->_slots[i].load(std::memory_order_acquire);
+      if(voice != nullptr) voice->Mix(mix, frames, channels);
+    }
+    FromFloat(sample, mix, static_cast<uint8_t*>(buffer.output) + done * frameSize, frames * channels);
+  }
+  mixer->_cycles.fetch_add(1, std::memory_order_release);
+  return 0;
+}
+
+} // namespace Xt::Mixing
+#endif // XT_AUDIO_MIXER_HPP
\ No newline at end of file
@@ -0,0 +1,248 @@
+#ifndef XT_AUDIO_POOL_HPP
+#define XT_AUDIO_POOL_HPP
+
+/** @file */
+/** @cond */
+#include <xt/XtAudio.hpp>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <stdexcept>
+/** @endcond */
+
+namespace Xt::Pooling {
+
+class Pool;
+struct Slot;
+
+// A stream handed out by a pool. Releasing the lease (on destruction)
+// resets the stream and parks it again instead of closing it. Leases
+// must be released on the main thread, before the pool is destroyed.
+class Lease final
+{
+  Pool* _pool;
+  Slot* _slot;
+public:
+  ~Lease() { Release(); }
+  Lease(): _pool(nullptr), _slot(nullptr) { }
+  Lease(Pool* pool, Slot* slot): _pool(pool), _slot(slot) { }
+  Lease(Lease&& rhs) noexcept:
+  _pool(std::exchange(rhs._pool, nullptr)), _slot(std::exchange(rhs._slot, nullptr)) { }
+  Lease& operator=(Lease&& rhs) noexcept;
+
+  void Release() noexcept;
+  Stream& GetStream() const;
+  explicit operator bool() const { return _slot != nullptr; }
+};
+
+// Leased is only touched on the main thread. Attached tells callbacks
+// whether to forward to the lease, the user data itself is opaque and
+// may well be null.
+struct Slot final
+{
+  bool leased = false;
+  Pool* pool = nullptr;
+  void* user = nullptr;
+  std::atomic<bool> attached{false};
+  std::unique_ptr<Stream> stream;
+};
+
+// Keeps streams for a single device configuration opened ahead of time,
+// so a session does not pay for device open, buffer negotiation and
+// stream thread creation before the first sample plays. If the service
+// supports pausing, idle streams are started and paused, leaving the
+// device prepared and the stream thread parked; acquiring one only
+// resumes it. Otherwise idle streams are kept opened and stopped.
+// All streams share the callbacks in params.stream, each lease passes
+// its own user data. Idle streams output silence and drop events.
+// Resumed streams raise no running events. Pool methods may only be
+// called from the main thread.
+class Pool final
+{
+  bool _pause;
+  Device* _device;
+  DeviceStreamParams _params;
+  std::vector<std::unique_ptr<Slot>> _slots;
+
+  friend class Lease;
+  void Park(Slot& slot);
+  void Release(Slot* slot) noexcept;
+  static void
+  OnXRun(Stream const& stream, int32_t index, void* user);
+  static uint32_t
+  OnBuffer(Stream const& stream, Buffer const& buffer, void* user);
+  static void
+  OnRunning(Stream const& stream, bool running, uint64_t error, void* user);
+  static void
+  OnReconfigure(Stream const& stream, int32_t frames, int32_t rate, void* user);
+public:
+  Pool(Pool const&) = delete;
+  Pool& operator=(Pool const&) = delete;
+  Pool(Service const& service, Device& device, DeviceStreamParams const& params, int32_t count);
+
+  int32_t GetAvailable() const;
+  Lease Acquire(void* user);
+};
+
+inline Lease&
+Lease::operator=(Lease&& rhs) noexcept
+{
+  if(this == &rhs) return *this;
+  Release();
+  _pool = std::exchange(rhs._pool, nullptr);
+  _slot = std::exchange(rhs._slot, nullptr);
+  return *this;
+}
+
+inline Stream&
+Lease::GetStream() const
+{
+  if(_slot == nullptr) throw std::logic_error("Lease is empty.");
+  return *_slot->stream;
+}
+
+inline void
+Lease::Release() noexcept
+{
+  if(_slot != nullptr) _pool->Release(_slot);
+  _pool = nullptr;
+  _slot = nullptr;
+}
+
+inline
+Pool::Pool(Service const& service, Device& device, DeviceStreamParams const& params, int32_t count):
+_pause((service.GetCapabilities() & ServiceCapsPause) != 0), _device(&device), _params(params)
+{
+  if(count < 0) throw std::invalid_argument("count");
+  if(params.stream.onBuffer == nullptr) throw std::invalid_argument("onBuffer");
+  for(int32_t i = 0; i < count; i++)
+  {
+    _slots.push_back(std::make_unique<Slot>());
+    _slots.back()->pool = this;
+    Park(*_slots.back());
+  }
+}
+
+inline int32_t
+Pool::GetAvailable() const
+{
+  int32_t result = 0;
+  for(auto const& slot: _slots) result += slot->leased? 0: 1;
+  return result;
+}
+
+// Opens the stream if needed. Prefilling while parking runs the buffer
+// callback without a lease, so the device is primed with silence.
+inline void
+Pool::Park(Slot& slot)
+{
+  DeviceStreamParams params = _params;
+  params.stream.onXRun = &Pool::OnXRun;
+  params.stream.onBuffer = &Pool::OnBuffer;
+  params.stream.onRunning = &Pool::OnRunning;
+  params.stream.onReconfigure = &Pool::OnReconfigure;
+  if(!slot.stream) slot.stream = _device->OpenStream(params, &slot);
+  if(!_pause) return;
+  slot.stream->Start();
+  slot.stream->SetPaused(true);
+}
+
+// Falls back to opening a new stream when all parked ones are leased.
+// A stream which failed to park or resume earlier is reopened.
+inline Lease
+Pool::Acquire(void* user)
+{
+  Slot* slot = nullptr;
+  for(auto const& s: _slots)
+    if(!s->leased && (slot == nullptr || (!slot->stream && s->stream))) slot = s.get();
+  if(slot == nullptr)
+  {
+    _slots.push_back(std::make_unique<Slot>());
+    slot = _slots.back().get();
+    slot->pool = this;
+  }
+  try
+  {
+    if(!slot->stream) Park(*slot);
+    slot->user = user;
+    slot->attached.store(true, std::memory_order_release);
+    if(_pause) slot->stream->SetPaused(false);
+    else slot->stream->Start();
+  } catch(...)
+  {
+    slot->attached.store(false);
+    slot->stream.reset();
+    throw;
+  }
+  slot->leased = true;
+  return Lease(this, slot);
+}
+
+// Stop waits for the stream thread, so no callback reaches the
+// lease's user data after this returns. Stopping also resets the
+// stream position before it is parked again.
+inline void
+Pool::Release(Slot* slot) noexcept
+{
+  slot->attached.store(false, std::memory_order_release);
+  try
+  {
+    slot->stream->Stop();
+    Park(*slot);
+  } catch(...)
+  {
+    slot->stream.reset();
+  }
+  slot->leased = false;
+}
+
+inline void
+Pool::OnXRun(Stream const& stream, int32_t index, void* user)
+{
+  auto slot = static_cast<Slot*>(user);
+  bool attached = slot->attached.load(std::memory_order_acquire);
+  auto onXRun = slot->pool->_params.stream.onXRun;
+  if(attached && onXRun != nullptr) onXRun(stream, index, slot->user);
+}
+
+inline void
+Pool::OnRunning(Stream const& stream, bool running, uint64_t error, void* user)
+{
+  auto slot = static_cast<Slot*>(user);
+  bool attached = slot->attached.load(std::memory_order_acquire);
+  auto onRunning = slot->pool->_params.stream.onRunning;
+  if(attached && onRunning != nullptr) onRunning(stream, running, error, slot->user);
+}
+
+inline void
+Pool::OnReconfigure(Stream const& stream, int32_t frames, int32_t rate, void* user)
+{
+  auto slot = static_cast<Slot*>(user);
+  bool attached = slot->attached.load(std::memory_order_acquire);
+  auto onReconfigure = slot->pool->_params.stream.onReconfigure;
+  if(attached && onReconfigure != nullptr) onReconfigure(stream, frames, rate, slot->user);
+}
+
+inline uint32_t
+Pool::OnBuffer(Stream const& stream, Buffer const& buffer, void* user)
+{
+  auto slot = static_cast<Slot*>(user);
+  bool attached = slot->attached.load(std::memory_order_acquire);
+  if(attached) return slot->pool->_params.stream.onBuffer(stream, buffer, slot->user);
+  if(buffer.output == nullptr) return 0;
+  Format const& format = stream.GetFormat();
+  int32_t size = Audio::GetSampleAttributes(format.mix.sample).size;
+  uint8_t silence = format.mix.sample == Sample::UInt8? 0x80: 0;
+  if(slot->pool->_params.stream.interleaved)
+    std::memset(buffer.output, silence, static_cast<size_t>(buffer.frames) * format.channels.outputs * size);
+  else for(int32_t c = 0; c < format.channels.outputs; c++)
+    std::memset(static_cast<void**>(buffer.output)[c], silence, static_cast<size_t>(buffer.frames) * size);
+  return 0;
+}
+
+} // namespace Xt::Pooling
+#endif // XT_AUDIO_POOL_HPP
\ No newline at end of file
@@ -0,0 +1,177 @@
+#ifndef XT_AUDIO_ROUND_TRIP_HPP
+#define XT_AUDIO_ROUND_TRIP_HPP
+
+/** @file */
+/** @cond */
+#include <xt/XtAudio.hpp>
+#include <xt/XtAudioMixer.hpp>
+
+#include <cmath>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+/** @endcond */
+
+namespace Xt::RoundTrip {
+
+// All times in milliseconds. Repetitions in which the sequence was not
+// found in the captured input are not counted as detected.
+struct Result
+{
+  int32_t detected;
+  int32_t repetitions;
+  double latency;
+  double minimum;
+  double maximum;
+  double jitter;
+};
+
+// Measures true input-to-output latency over a duplex or aggregate
+// stream whose output is looped back into its input (a cable, ALSA's
+// snd-aloop or a software loopback device). A maximum length sequence
+// is played on all output channels once per period, the first input
+// channel is captured, and Analyze() cross-correlates both to find the
+// lag in each period. In a duplex callback input and output frames at
+// the same position are exchanged together, so the lag is the round
+// trip latency. Open the stream with Probe::OnBuffer and the probe as
+// user data, run it until IsDone() and call Analyze() once stopped.
+class Probe final
+{
+  Format _format;
+  bool _interleaved;
+  int32_t _length;
+  int32_t _period;
+  int32_t _repetitions;
+  uint64_t _position;
+  std::atomic<bool> _done;
+  std::vector<float> _capture;
+  std::vector<float> _sequence;
+  static inline double const Threshold = 0.5;
+  static inline float const Amplitude = 0.5f;
+
+  void Process(Buffer const& buffer);
+public:
+  Probe(Format const& format, bool interleaved, double maxLatency = 250.0, int32_t repetitions = 8, int32_t order = 12);
+
+  Result Analyze() const;
+  bool IsDone() const { return _done.load(std::memory_order_acquire); }
+  double GetDuration() const { return _capture.size() * 1000.0 / _format.mix.rate; }
+  static uint32_t OnBuffer(Stream const& stream, Buffer const& buffer, void* user);
+};
+
+// Galois LFSR feedback masks giving maximum length sequences.
+inline uint32_t const
+SequenceMasks[] = { 0xB8, 0x110, 0x240, 0x500, 0xE08, 0x1C80, 0x3802, 0x6000, 0xD008 };
+
+inline
+Probe::Probe(Format const& format, bool interleaved, double maxLatency, int32_t repetitions, int32_t order):
+_format(format), _interleaved(interleaved), _length(0), _period(0),
+_repetitions(repetitions), _position(0), _done(false)
+{
+  if(order < 8 || order > 16) throw std::invalid_argument("order");
+  if(repetitions <= 0) throw std::invalid_argument("repetitions");
+  if(maxLatency <= 0.0) throw std::invalid_argument("maxLatency");
+  if(format.channels.inputs <= 0 || format.channels.outputs <= 0) throw std::invalid_argument("format");
+  _length = (1 << order) - 1;
+  _period = _length + static_cast<int32_t>(std::ceil(maxLatency / 1000.0 * format.mix.rate));
+  _capture.resize(static_cast<size_t>(_period) * repetitions);
+  uint32_t state = 1;
+  uint32_t mask = SequenceMasks[order - 8];
+  for(int32_t i = 0; i < _length; i++)
+  {
+    _sequence.push_back((state & 1) != 0? Amplitude: -Amplitude);
+    state = (state >> 1) ^ ((state & 1) != 0? mask: 0);
+  }
+}
+
+inline uint32_t
+Probe::OnBuffer(Stream const& stream, Buffer const& buffer, void* user)
+{
+  static_cast<Probe*>(user)->Process(buffer);
+  return 0;
+}
+
+// Converts sample by sample, the probe is not meant to be cheap.
+inline void
+Probe::Process(Buffer const& buffer)
+{
+  Sample sample = _format.mix.sample;
+  uint64_t total = _capture.size();
+  int32_t inputs = _format.channels.inputs;
+  int32_t outputs = _format.channels.outputs;
+  int32_t size = Audio::GetSampleAttributes(sample).size;
+  for(int32_t f = 0; f < buffer.frames; f++)
+  {
+    float value = 0.0f;
+    uint64_t position = _position + f;
+    auto offset = static_cast<int32_t>(position % _period);
+    if(position < total && offset < _length) value = _sequence[offset];
+    for(int32_t c = 0; buffer.output != nullptr && c < outputs; c++)
+    {
+      auto output = static_cast<uint8_t*>(buffer.output);
+      if(!_interleaved) output = static_cast<uint8_t**>(buffer.output)[c];
+      Mixing::FromFloat(sample, &value, output + (_interleaved? f * outputs + c: f) * size, 1);
+    }
+    if(position >= total || buffer.input == nullptr) continue;
+    auto input = static_cast<uint8_t const*>(buffer.input);
+    if(!_interleaved) input = static_cast<uint8_t const* const*>(buffer.input)[0];
+    Mixing::ToFloat(sample, input + (_interleaved? f * inputs: f) * size, &_capture[position], 1);
+  }
+  _position += buffer.frames;
+  if(_position >= total) _done.store(true, std::memory_order_release);
+}
+
+// Normalized cross-correlation per period, refined to a fraction
+// of a frame by fitting a parabola through the peak.
+inline Result
+Probe::Analyze() const
+{
+  Result result = { 0 };
+  std::vector<double> lags;
+  int32_t maxLag = _period - _length;
+  std::vector<double> correlation(static_cast<size_t>(maxLag) + 1);
+  double energy = _length * static_cast<double>(Amplitude) * Amplitude;
+  result.repetitions = _repetitions;
+  for(int32_t r = 0; r < _repetitions; r++)
+  {
+    int32_t peak = 0;
+    double peakNormalized = 0.0;
+    double window = 0.0;
+    float const* capture = _capture.data() + static_cast<size_t>(r) * _period;
+    for(int32_t i = 0; i < _length; i++) window += static_cast<double>(capture[i]) * capture[i];
+    for(int32_t d = 0; d <= maxLag; d++)
+    {
+      double sum = 0.0;
+      if(d > 0) window += static_cast<double>(capture[d + _length - 1]) * capture[d + _length - 1];
+      if(d > 0) window = std::max(window - static_cast<double>(capture[d - 1]) * capture[d - 1], 0.0);
+      for(int32_t i = 0; i < _length; i++) sum += static_cast<double>(_sequence[i]) * capture[d + i];
+      correlation[d] = std::fabs(sum);
+      double normalized = window > 0.0? correlation[d] / std::sqrt(energy * window): 0.0;
+      if(normalized > peakNormalized) peak = d, peakNormalized = normalized;
+    }
+    if(peakNormalized < Threshold) continue;
+    double lag = peak;
+    if(peak > 0 && peak < maxLag)
+    {
+      double l = correlation[peak - 1];
+      double c = correlation[peak];
+      double h = correlation[peak + 1];
+      double denominator = l - 2.0 * c + h;
+      if(denominator != 0.0) lag += 0.5 * (l - h) / denominator;
+    }
+    lags.push_back(lag * 1000.0 / _format.mix.rate);
+  }
+  result.detected = static_cast<int32_t>(lags.size());
+  if(lags.empty()) return result;
+  result.minimum = *std::min_element(lags.begin(), lags.end());
+  result.maximum = *std::max_element(lags.begin(), lags.end());
+  for(double lag: lags) result.latency += lag / lags.size();
+  for(double lag: lags) result.jitter += (lag - result.latency) * (lag - result.latency) / lags.size();
+  result.jitter = std::sqrt(result.jitter);
+  return result;
+}
+
+} // namespace Xt::RoundTrip
+#endif // XT_AUDIO_ROUND_TRIP_HPP
\ No newline at end of file
@@ -0,0 +1,85 @@
+#ifndef XT_API_BUFFER_VIEW_HPP
+#define XT_API_BUFFER_VIEW_HPP
+
+/** @file */
+/** @cond */
+#include <xt/api/Enums.hpp>
+
+#include <cstdint>
+#include <type_traits>
+/** @endcond */
+
+namespace Xt {
+
+enum class Layout { Interleaved, NonInterleaved };
+
+struct Int24 final 
+{ 
+  uint8_t bytes[3]; 
+};
+
+template <class T> 
+struct SampleTraits;
+template <> struct SampleTraits<uint8_t> 
+{ static constexpr Sample sample = Sample::UInt8; };
+template <> struct SampleTraits<int16_t> 
+{ static constexpr Sample sample = Sample::Int16; };
+template <> struct SampleTraits<Int24> 
+{ static constexpr Sample sample = Sample::Int24; };
+template <> struct SampleTraits<int32_t> 
+{ static constexpr Sample sample = Sample::Int32; };
+template <> struct SampleTraits<float> 
+{ static constexpr Sample sample = Sample::Float32; };
+
+template <class T, Layout L>
+class SampleView;
+
+template <class T>
+class SampleView<T, Layout::Interleaved> final
+{
+  T* _data;
+  int32_t _frames;
+  int32_t _channels;
+  using Raw = std::conditional_t<std::is_const_v<T>, void const*, void*>;
+public:
+  SampleView(Raw data, int32_t frames, int32_t channels):
+  _data(static_cast<T*>(data)), _frames(frames), _channels(channels) { }
+
+  T* Data() const { return _data; }
+  int32_t Frames() const { return _frames; }
+  int32_t Channels() const { return _channels; }
+  T* Frame(int32_t frame) const { return _data + frame * _channels; }
+  T& operator()(int32_t frame, int32_t channel) const { return _data[frame * _channels + channel]; }
+};
+
+template <class T>
+class SampleView<T, Layout::NonInterleaved> final
+{
+  T* const* _data;
+  int32_t _frames;
+  int32_t _channels;
+  using Raw = std::conditional_t<std::is_const_v<T>, void const*, void*>;
+public:
+  SampleView(Raw data, int32_t frames, int32_t channels):
+  _data(static_cast<T* const*>(data)), _frames(frames), _channels(channels) { }
+
+  T* const* Data() const { return _data; }
+  int32_t Frames() const { return _frames; }
+  int32_t Channels() const { return _channels; }
+  T* Channel(int32_t channel) const { return _data[channel]; }
+  T& operator()(int32_t frame, int32_t channel) const { return _data[channel][frame]; }
+};
+
+template <class T, Layout L>
+struct BufferView final 
+{
+  SampleView<T const, L> input;
+  SampleView<T, L> output;
+  double time;
+  uint64_t position;
+  int32_t frames;
+  bool timeValid;
+};
+
+} // namespace Xt
+#endif // XT_API_BUFFER_VIEW_HPP
\ No newline at end of file
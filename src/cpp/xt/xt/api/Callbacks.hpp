@@ -17,6 +17,10 @@ typedef uint32_t (*
 OnBuffer)(class Stream const& stream, struct Buffer const& buffer, void* user);
 typedef void (*
 OnRunning)(class Stream const& stream, bool running, uint64_t error, void* user);
+typedef void (*
+OnReconfigure)(class Stream const& stream, int32_t frames, int32_t rate, void* user);
+typedef void (*
+OnBudgetExceeded)(class Stream const& stream, double duration, double budget, void* user);
 
 } // namespace Xt
 #endif // XT_API_CALLBACKS_HPP
\ No newline at end of file
@@ -28,6 +28,21 @@ struct Latency final
   double output;
 };
 
+struct RingStats final 
+{
+  int32_t readable;
+  int32_t writable;
+  uint64_t overflows;
+  uint64_t underflows;
+};
+
+struct RecordingStats final 
+{
+  uint64_t written;
+  uint64_t lag;
+  uint64_t dropped;
+};
+
 struct Version final 
 {
   int32_t major;
@@ -97,9 +112,12 @@ struct StreamParams final
   OnBuffer onBuffer;
   OnXRun onXRun;
   OnRunning onRunning;
+  OnReconfigure onReconfigure = nullptr;
   StreamParams() = default;
   StreamParams(bool interleaved, OnBuffer onBuffer, OnXRun onXRun, OnRunning onRunning):
   interleaved(interleaved), onBuffer(onBuffer), onXRun(onXRun), onRunning(onRunning) {}
+  StreamParams(bool interleaved, OnBuffer onBuffer, OnXRun onXRun, OnRunning onRunning, OnReconfigure onReconfigure):
+  interleaved(interleaved), onBuffer(onBuffer), onXRun(onXRun), onRunning(onRunning), onReconfigure(onReconfigure) {}
 };
 
 struct DeviceStreamParams final 
@@ -24,6 +24,8 @@ class Audio final
 public:
   static Version GetVersion();
   static void SetOnError(OnError onError);
+  static uint64_t GetRtViolations();
+  static bool WriteTrace(std::string const& path);
   static ErrorInfo GetErrorInfo(uint64_t error);
   static Attributes GetSampleAttributes(Sample sample);
   static std::unique_ptr<Platform> Init(std::string const& id, void* window);
@@ -68,6 +70,14 @@ Audio::Init(std::string const& id, void* window)
   return std::unique_ptr<Platform>(new Platform(result));
 }
 
+inline uint64_t
+Audio::GetRtViolations()
+{ return Detail::HandleAssert(XtAudioGetRtViolations()); }
+
+inline bool
+Audio::WriteTrace(std::string const& path)
+{ return Detail::HandleAssert(XtAudioWriteTrace(path.c_str())) != XtFalse; }
+
 inline void
 Audio::SetOnError(OnError onError)
 { 
@@ -7,10 +7,15 @@
 #include <xt/cpp/Error.hpp>
 #include <xt/api/Structs.hpp>
 #include <xt/api/XtStream.hpp>
+#include <xt/cpp/Forward.hpp>
+#include <xt/api/BufferView.hpp>
 
 #include <memory>
 #include <vector>
+#include <utility>
 #include <optional>
+#include <stdexcept>
+#include <type_traits>
 /** @endcond */
 
 namespace Xt {
@@ -35,6 +40,8 @@ public:
   BufferSize GetBufferSize(Format const& format) const;
   std::string GetChannelName(bool output, int32_t index) const;
   std::unique_ptr<Stream> OpenStream(DeviceStreamParams const& params, void* user);
+  template <class T, Layout L, class F>
+  std::unique_ptr<Stream> OpenStream(DeviceStreamParams const& params, F&& onBuffer, void* user);
 };
 
 inline
@@ -108,16 +115,48 @@ Device::OpenStream(DeviceStreamParams const& params, void* user)
   XtStream* stream; 
   XtDeviceStreamParams coreParams = { 0 };
   coreParams.bufferSize = params.bufferSize;
-  coreParams.stream.onBuffer = &Detail::ForwardOnBuffer;
+  coreParams.stream.onBuffer = params.stream.onBuffer == nullptr? nullptr: &Detail::ForwardOnBuffer;
   coreParams.stream.interleaved = params.stream.interleaved;
   coreParams.format = *reinterpret_cast<XtFormat const*>(&params.format);
   coreParams.stream.onXRun = params.stream.onXRun == nullptr? nullptr: &Detail::ForwardOnXRun;
   coreParams.stream.onRunning = params.stream.onRunning == nullptr? nullptr: &Detail::ForwardOnRunning;
+  coreParams.stream.onReconfigure = params.stream.onReconfigure == nullptr? nullptr: &Detail::ForwardOnReconfigure;
   std::unique_ptr<Stream> result(new Stream(params.stream, user));
   Detail::HandleError(XtDeviceOpenStream(_d, &coreParams, result.get(), &stream));
   result->_s = stream;
   return result;
 }
 
+// Calls onBuffer(Stream const&, BufferView<T, L> const&) through a trampoline 
+// generated for the callable. params.stream.onBuffer and interleaved are ignored.
+template <class T, Layout L, class F>
+inline std::unique_ptr<Stream> 
+Device::OpenStream(DeviceStreamParams const& params, F&& onBuffer, void* user) 
+{
+  using Typed = Detail::TypedOnBuffer<std::decay_t<F>>;
+  if(params.format.mix.sample != SampleTraits<T>::sample)
+    throw std::logic_error("Sample type does not match the stream format.");
+  StreamParams streamParams = params.stream;
+  streamParams.onBuffer = nullptr;
+  streamParams.interleaved = L == Layout::Interleaved;
+  std::unique_ptr<Stream> result(new Stream(streamParams, user));
+  auto const& channels = params.format.channels;
+  auto typed = new Typed{ std::forward<F>(onBuffer), channels.inputs, channels.outputs };
+  result->_onTypedBuffer = std::unique_ptr<void, void(*)(void*)>(typed, [](void* p) { delete static_cast<Typed*>(p); });
+
+  XtStream* stream; 
+  XtDeviceStreamParams coreParams = { 0 };
+  coreParams.bufferSize = params.bufferSize;
+  coreParams.stream.onBuffer = &Detail::ForwardOnTypedBuffer<T, L, std::decay_t<F>>;
+  coreParams.stream.interleaved = streamParams.interleaved;
+  coreParams.format = *reinterpret_cast<XtFormat const*>(&params.format);
+  coreParams.stream.onXRun = streamParams.onXRun == nullptr? nullptr: &Detail::ForwardOnXRun;
+  coreParams.stream.onRunning = streamParams.onRunning == nullptr? nullptr: &Detail::ForwardOnRunning;
+  coreParams.stream.onReconfigure = streamParams.onReconfigure == nullptr? nullptr: &Detail::ForwardOnReconfigure;
+  Detail::HandleError(XtDeviceOpenStream(_d, &coreParams, result.get(), &stream));
+  result->_s = stream;
+  return result;
+}
+
 } // namespace Xt
 #endif // XT_API_DEVICE_HPP
\ No newline at end of file
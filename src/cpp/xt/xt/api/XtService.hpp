@@ -87,11 +87,12 @@ Service::AggregateStream(AggregateStreamParams const& params, void* user)
   coreParams.devices = ds.data();
   coreParams.count = params.count;
   coreParams.master = params.master->_d;
-  coreParams.stream.onBuffer = Detail::ForwardOnBuffer;
+  coreParams.stream.onBuffer = params.stream.onBuffer == nullptr? nullptr: Detail::ForwardOnBuffer;
   coreParams.stream.interleaved = params.stream.interleaved;
   coreParams.mix = *reinterpret_cast<XtMix const*>(&params.mix);
   coreParams.stream.onXRun = params.stream.onXRun == nullptr? nullptr: Detail::ForwardOnXRun;
   coreParams.stream.onRunning = params.stream.onRunning == nullptr? nullptr: Detail::ForwardOnRunning;
+  coreParams.stream.onReconfigure = params.stream.onReconfigure == nullptr? nullptr: Detail::ForwardOnReconfigure;
   std::unique_ptr<Stream> result(new Stream(params.stream, user));
   Detail::HandleError(XtServiceAggregateStream(_s, &coreParams, result.get(), &stream));
   result->_s = stream;
@@ -6,8 +6,11 @@
 #include <xt/cpp/Core.hpp>
 #include <xt/cpp/Error.hpp>
 #include <xt/api/Structs.hpp>
+#include <xt/cpp/Forward.hpp>
 #include <xt/api/Callbacks.hpp>
 
+#include <memory>
+#include <string>
 #include <cstdint>
 /** @endcond */
 
@@ -20,18 +23,34 @@ class Stream final
   XtStream* _s;
   void* const _user;
   StreamParams const _params;
+  OnBudgetExceeded _onBudgetExceeded;
+  std::unique_ptr<void, void(*)(void*)> _onTypedBuffer;
 
   Stream(StreamParams const& params, void* user):
-  _s(nullptr), _params(params), _user(user) { }
+  _s(nullptr), _params(params), _user(user), 
+  _onBudgetExceeded(nullptr), _onTypedBuffer(nullptr, nullptr) { }
 
 public:
   ~Stream();
   void Stop();
   void Start();
+  void Rewind();
+  void SetPaused(bool paused);
+  void SetFreewheel(bool freewheel);
+  void SetBufferSize(double bufferSize);
   bool IsRunning() const;
   void* GetHandle() const;
   int32_t GetFrames() const;
   Latency GetLatency() const;
+  void StopRecording();
+  RecordingStats GetRecordingStats() const;
+  void StartRecording(std::string const& path, bool output);
+  RingStats GetRingStats() const;
+  int32_t GetReadyFd(int32_t frames);
+  void SetBudget(double fraction, OnBudgetExceeded onBudgetExceeded);
+  void InitRings(int32_t frames, int32_t prebuffer);
+  int32_t Read(void* data, int32_t frames, int32_t timeout = -1);
+  int32_t Write(void const* data, int32_t frames, int32_t timeout = -1);
   Format const& GetFormat() const;
 
 /** @cond */
@@ -43,6 +62,12 @@ public:
   Detail::ForwardOnBuffer(XtStream const* coreStream, XtBuffer const* coreBuffer, void* user);
   friend void XT_CALLBACK 
   Detail::ForwardOnRunning(XtStream const* coreStream, XtBool running, uint64_t error, void* user);
+  friend void XT_CALLBACK 
+  Detail::ForwardOnReconfigure(XtStream const* coreStream, int32_t frames, int32_t rate, void* user);
+  friend void XT_CALLBACK 
+  Detail::ForwardOnBudgetExceeded(XtStream const* coreStream, double duration, double budget, void* user);
+  template <class T, Layout L, class F> friend uint32_t XT_CALLBACK 
+  Detail::ForwardOnTypedBuffer(XtStream const* coreStream, XtBuffer const* coreBuffer, void* user);
 /** @endcond */
 };
 
@@ -52,6 +77,24 @@ Stream::Start()
 inline void
 Stream::Stop() 
 { Detail::HandleAssert(XtStreamStop, _s); }
+inline void
+Stream::Rewind() 
+{ Detail::HandleAssert(XtStreamRewind, _s); }
+inline void
+Stream::SetFreewheel(bool freewheel) 
+{ Detail::HandleError(XtStreamSetFreewheel(_s, freewheel)); }
+inline void
+Stream::SetPaused(bool paused) 
+{ Detail::HandleError(XtStreamSetPaused(_s, paused)); }
+inline void
+Stream::SetBufferSize(double bufferSize) 
+{ Detail::HandleError(XtStreamSetBufferSize(_s, bufferSize)); }
+inline void
+Stream::StopRecording() 
+{ Detail::HandleAssert(XtStreamStopRecording, _s); }
+inline void
+Stream::StartRecording(std::string const& path, bool output) 
+{ Detail::HandleError(XtStreamStartRecording(_s, path.c_str(), output)); }
 inline
 Stream::~Stream() 
 { Detail::HandleDestroy(XtStreamDestroy, _s); }
@@ -79,6 +122,47 @@ Stream::GetLatency() const
   return latency;
 }
 
+inline void
+Stream::InitRings(int32_t frames, int32_t prebuffer) 
+{ Detail::HandleAssert(XtStreamInitRings, _s, frames, prebuffer); }
+inline int32_t
+Stream::Read(void* data, int32_t frames, int32_t timeout) 
+{ return Detail::HandleAssert(XtStreamRead(_s, data, frames, timeout)); }
+inline int32_t
+Stream::Write(void const* data, int32_t frames, int32_t timeout) 
+{ return Detail::HandleAssert(XtStreamWrite(_s, data, frames, timeout)); }
+
+inline int32_t
+Stream::GetReadyFd(int32_t frames) 
+{ return Detail::HandleAssert(XtStreamGetReadyFd(_s, frames)); }
+
+inline void
+Stream::SetBudget(double fraction, OnBudgetExceeded onBudgetExceeded) 
+{
+  auto forward = onBudgetExceeded == nullptr? nullptr: &Detail::ForwardOnBudgetExceeded;
+  if(onBudgetExceeded != nullptr) _onBudgetExceeded = onBudgetExceeded;
+  Detail::HandleAssert(XtStreamSetBudget, _s, fraction, forward);
+  _onBudgetExceeded = onBudgetExceeded;
+}
+
+inline RingStats
+Stream::GetRingStats() const
+{
+  RingStats stats;
+  auto coreStats = reinterpret_cast<XtRingStats*>(&stats);
+  Detail::HandleAssert(XtStreamGetRingStats, _s, coreStats);
+  return stats;
+}
+
+inline RecordingStats
+Stream::GetRecordingStats() const
+{
+  RecordingStats stats;
+  auto coreStats = reinterpret_cast<XtRecordingStats*>(&stats);
+  Detail::HandleAssert(XtStreamGetRecordingStats, _s, coreStats);
+  return stats;
+}
+
 inline Format const& 
 Stream::GetFormat() const
 {
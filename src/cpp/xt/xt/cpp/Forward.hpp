@@ -2,6 +2,7 @@
 #define XT_CPP_FORWARD_HPP
 
 #include <xt/cpp/Core.hpp>
+#include <xt/api/BufferView.hpp>
 
 namespace Xt::Detail {
 
@@ -15,6 +16,20 @@ inline uint32_t XT_CALLBACK
 ForwardOnBuffer(XtStream const* coreStream, XtBuffer const* coreBuffer, void* user);
 inline void XT_CALLBACK 
 ForwardOnRunning(XtStream const* coreStream, XtBool running, uint64_t error, void* user);
+inline void XT_CALLBACK 
+ForwardOnReconfigure(XtStream const* coreStream, int32_t frames, int32_t rate, void* user);
+inline void XT_CALLBACK 
+ForwardOnBudgetExceeded(XtStream const* coreStream, double duration, double budget, void* user);
+template <class T, Layout L, class F> inline uint32_t XT_CALLBACK 
+ForwardOnTypedBuffer(XtStream const* coreStream, XtBuffer const* coreBuffer, void* user);
+
+template <class F>
+struct TypedOnBuffer final
+{
+  F onBuffer;
+  int32_t inputs;
+  int32_t outputs;
+};
 
 } // namespace Xt::Detail
 #endif // XT_CPP_FORWARD_HPP
\ No newline at end of file
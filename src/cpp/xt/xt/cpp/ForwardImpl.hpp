@@ -28,6 +28,20 @@ ForwardOnBuffer(XtStream const* coreStream, XtBuffer const* coreBuffer, void* us
   return stream->_params.onBuffer(*stream, buffer, stream->_user);
 }
 
+// Instantiated per callable type, so the user's per-frame loops 
+// inline into the trampoline with the sample type and layout known.
+template <class T, Layout L, class F> inline uint32_t XT_CALLBACK 
+ForwardOnTypedBuffer(XtStream const* coreStream, XtBuffer const* coreBuffer, void* user)
+{
+  auto stream = static_cast<Stream*>(user);
+  auto typed = static_cast<TypedOnBuffer<F>*>(stream->_onTypedBuffer.get());
+  BufferView<T, L> buffer = {
+    SampleView<T const, L>(coreBuffer->input, coreBuffer->frames, typed->inputs),
+    SampleView<T, L>(coreBuffer->output, coreBuffer->frames, typed->outputs),
+    coreBuffer->time, coreBuffer->position, coreBuffer->frames, coreBuffer->timeValid != XtFalse };
+  return typed->onBuffer(*static_cast<Stream const*>(stream), buffer);
+}
+
 inline void XT_CALLBACK 
 ForwardOnRunning(XtStream const* coreStream, XtBool running, uint64_t error, void* user)
 {  
@@ -35,5 +49,19 @@ ForwardOnRunning(XtStream const* coreStream, XtBool running, uint64_t error, voi
   stream->_params.onRunning(*stream, running != 0, error, stream->_user);
 }
 
+inline void XT_CALLBACK 
+ForwardOnReconfigure(XtStream const* coreStream, int32_t frames, int32_t rate, void* user)
+{  
+  auto stream = static_cast<Stream*>(user);
+  stream->_params.onReconfigure(*stream, frames, rate, stream->_user);
+}
+
+inline void XT_CALLBACK 
+ForwardOnBudgetExceeded(XtStream const* coreStream, double duration, double budget, void* user)
+{  
+  auto stream = static_cast<Stream*>(user);
+  stream->_onBudgetExceeded(*stream, duration, budget, stream->_user);
+}
+
 } // namespace Xt::Detail
 #endif // XT_CPP_FORWARD_IMPL_HPP
\ No newline at end of file
@@ -13,10 +13,12 @@ import xt.audio.Structs.XtMix;
 import xt.audio.Structs.XtStreamParams;
 import xt.audio.XtAudio;
 import xt.audio.XtDevice;
+import xt.audio.XtDirectBuffer;
 import xt.audio.XtPlatform;
 import xt.audio.XtSafeBuffer;
 import xt.audio.XtService;
 import xt.audio.XtStream;
+import java.nio.FloatBuffer;
 
 public class RenderAdvanced {
 
@@ -60,6 +62,18 @@ public class RenderAdvanced {
         return 0;
     }
 
+    static int onInterleavedDirectBuffer(XtStream stream, XtBuffer buffer, Object user) throws Exception {
+        XtDirectBuffer direct = XtDirectBuffer.get(stream);
+        int channels = stream.getFormat().channels.outputs;
+        direct.update(buffer);
+        FloatBuffer output = (FloatBuffer)direct.getOutput();
+        for(int f = 0; f < buffer.frames; f++) {
+            float sample = nextSample();
+            for(int c = 0; c < channels; c++) output.put(f * channels + c, sample);
+        }
+        return 0;
+    }
+
     static int onInterleavedNativeBuffer(XtStream stream, XtBuffer buffer, Object user) throws Exception {
         int channels = stream.getFormat().channels.outputs;
         int size = XtAudio.getSampleAttributes(MIX.sample).size;
@@ -119,6 +133,14 @@ public class RenderAdvanced {
                     runStream(stream);
                 }
 
+                System.out.println("Render interleaved, direct buffers...");
+                streamParams = new XtStreamParams(true, RenderAdvanced::onInterleavedDirectBuffer, RenderAdvanced::onXRun, RenderAdvanced::onRunning);
+                deviceParams = new XtDeviceStreamParams(streamParams, format, size.current);
+                try(XtStream stream = device.openStream(deviceParams, null);
+                    XtDirectBuffer direct = XtDirectBuffer.register(stream, true)) {
+                    runStream(stream);
+                }
+
                 System.out.println("Render interleaved, native buffers...");
                 streamParams = new XtStreamParams(true, RenderAdvanced::onInterleavedNativeBuffer, RenderAdvanced::onXRun, RenderAdvanced::onRunning);
                 deviceParams = new XtDeviceStreamParams(streamParams, format, size.current);
@@ -20,4 +20,12 @@ public interface Callbacks {
     interface XtOnRunning {
         void callback(XtStream stream, boolean running, long error, Object user) throws Exception;
     }
+
+    interface XtOnReconfigure {
+        void callback(XtStream stream, int frames, int rate, Object user) throws Exception;
+    }
+
+    interface XtOnBudgetExceeded {
+        void callback(XtStream stream, double duration, double budget, Object user) throws Exception;
+    }
 }
\ No newline at end of file
@@ -5,7 +5,7 @@ public interface Enums {
     public enum XtSample { UINT8, INT16, INT24, INT32, FLOAT32 }
     public enum XtSetup { PRO_AUDIO, SYSTEM_AUDIO, CONSUMER_AUDIO }
     public enum XtCause { FORMAT, SERVICE, GENERIC, UNKNOWN, ENDPOINT }
-    public enum XtSystem { ALSA, ASIO, JACK, WASAPI, PULSE_AUDIO, DIRECT_SOUND }
+    public enum XtSystem { ALSA, ASIO, JACK, WASAPI, PULSE_AUDIO, DIRECT_SOUND, FILE }
 
     public enum XtEnumFlags {
         INPUT(0x1), OUTPUT(0x2), ALL(0x1|0x2);
@@ -20,7 +20,7 @@ public interface Enums {
     }
 
     public enum XtServiceCaps {
-        NONE(0x0), TIME(0x1), LATENCY(0x2), FULL_DUPLEX(0x4), AGGREGATION(0x8), CHANNEL_MASK(0x10), CONTROL_PANEL(0x20), XRUN_DETECTION(0x40);
+        NONE(0x0), TIME(0x1), LATENCY(0x2), FULL_DUPLEX(0x4), AGGREGATION(0x8), CHANNEL_MASK(0x10), CONTROL_PANEL(0x20), XRUN_DETECTION(0x40), FREEWHEEL(0x80), BUFFER_SIZE(0x100), PAUSE(0x200);
         final int _flag;
         private XtServiceCaps(int flag) { _flag = flag; }
     }
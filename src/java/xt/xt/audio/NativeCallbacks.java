@@ -16,4 +16,12 @@ interface NativeCallbacks {
     interface OnRunning extends Callback {
         void callback(Pointer stream, boolean running, long error, Pointer user) throws Exception;
     }
+
+    interface OnReconfigure extends Callback {
+        void callback(Pointer stream, int frames, int rate, Pointer user) throws Exception;
+    }
+
+    interface OnBudgetExceeded extends Callback {
+        void callback(Pointer stream, double duration, double budget, Pointer user) throws Exception;
+    }
 }
\ No newline at end of file
@@ -3,6 +3,7 @@ package xt.audio;
 import com.sun.jna.Pointer;
 import com.sun.jna.Structure;
 import xt.audio.NativeCallbacks.OnBuffer;
+import xt.audio.NativeCallbacks.OnReconfigure;
 import xt.audio.NativeCallbacks.OnRunning;
 import xt.audio.NativeCallbacks.OnXRun;
 import xt.audio.Structs.XtChannels;
@@ -45,7 +46,8 @@ interface NativeStructs {
         public OnBuffer onBuffer;
         public OnXRun onXRun;
         public OnRunning onRunning;
+        public OnReconfigure onReconfigure;
         public StreamParams() {}
-        @Override protected List getFieldOrder() { return Arrays.asList("interleaved", "onBuffer", "onXRun", "onRunning"); }
+        @Override protected List getFieldOrder() { return Arrays.asList("interleaved", "onBuffer", "onXRun", "onRunning", "onReconfigure"); }
     }
 }
\ No newline at end of file
@@ -4,6 +4,7 @@ import com.sun.jna.Pointer;
 import com.sun.jna.Structure;
 import com.sun.jna.TypeMapper;
 import xt.audio.Callbacks.XtOnBuffer;
+import xt.audio.Callbacks.XtOnReconfigure;
 import xt.audio.Callbacks.XtOnRunning;
 import xt.audio.Callbacks.XtOnXRun;
 import xt.audio.Enums.XtCause;
@@ -29,10 +30,14 @@ public interface Structs {
         public XtOnBuffer onBuffer;
         public XtOnXRun onXRun;
         public XtOnRunning onRunning;
+        public XtOnReconfigure onReconfigure;
         public XtStreamParams() {}
         public XtStreamParams(boolean interleaved, XtOnBuffer onBuffer, XtOnXRun onXRun, XtOnRunning onRunning) {
             this.interleaved = interleaved; this.onBuffer = onBuffer; this.onXRun = onXRun; this.onRunning = onRunning;
         }
+        public XtStreamParams(boolean interleaved, XtOnBuffer onBuffer, XtOnXRun onXRun, XtOnRunning onRunning, XtOnReconfigure onReconfigure) {
+            this(interleaved, onBuffer, onXRun, onRunning); this.onReconfigure = onReconfigure;
+        }
     }
 
     public static class XtVersion extends Structure {
@@ -48,6 +53,21 @@ public interface Structs {
         @Override protected List getFieldOrder() { return Arrays.asList("input", "output"); }
     }
 
+    public static class XtRingStats extends Structure {
+        public int readable;
+        public int writable;
+        public long overflows;
+        public long underflows;
+        @Override protected List getFieldOrder() { return Arrays.asList("readable", "writable", "overflows", "underflows"); }
+    }
+
+    public static class XtRecordingStats extends Structure {
+        public long written;
+        public long lag;
+        public long dropped;
+        @Override protected List getFieldOrder() { return Arrays.asList("written", "lag", "dropped"); }
+    }
+
     public static class XtDeviceStreamParams {
         public XtStreamParams stream;
         public XtFormat format;
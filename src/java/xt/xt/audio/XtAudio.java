@@ -20,11 +20,15 @@ public final class XtAudio {
     private static native Pointer XtAudioInit(String id, Pointer window);
     private static native XtErrorInfo.ByValue XtAudioGetErrorInfo(long error);
     private static native XtAttributes.ByValue XtAudioGetSampleAttributes(XtSample sample);
+    private static native boolean XtAudioWriteTrace(String path);
+    private static native long XtAudioGetRtViolations();
 
     private XtAudio() {}
 
     public static XtVersion getVersion() { return handleAssert(XtAudioGetVersion()); }
     public static XtErrorInfo getErrorInfo(long error) { return handleAssert(XtAudioGetErrorInfo(error)); }
+    public static boolean writeTrace(String path) { return handleAssert(XtAudioWriteTrace(path)); }
+    public static long getRtViolations() { return handleAssert(XtAudioGetRtViolations()); }
     public static void setOnError(XtOnError onError) { handleAssert(() -> XtAudioSetOnError(_onError = onError)); }
     public static XtPlatform init(String id, Pointer window) { return new XtPlatform(handleAssert(XtAudioInit(id, window))); }
     public static XtAttributes getSampleAttributes(XtSample sample) { return handleAssert(XtAudioGetSampleAttributes(sample)); }
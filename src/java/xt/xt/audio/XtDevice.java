@@ -84,10 +84,11 @@ public final class XtDevice implements AutoCloseable {
         native_.format = params.format;
         native_.stream = new StreamParams();
         native_.bufferSize = params.bufferSize;
-        native_.stream.onBuffer = result.onNativeBuffer();
+        native_.stream.onBuffer = params.stream.onBuffer == null? null: result.onNativeBuffer();
         native_.stream.interleaved = params.stream.interleaved;
         native_.stream.onXRun = params.stream.onXRun == null? null: result.onNativeXRun();
         native_.stream.onRunning = params.stream.onRunning == null? null: result.onNativeRunning();
+        native_.stream.onReconfigure = params.stream.onReconfigure == null? null: result.onNativeReconfigure();
         handleError(XtDeviceOpenStream(_d, native_, Pointer.NULL, stream));
         result.init(stream.getValue());
         return result;
@@ -0,0 +1,115 @@
+package xt.audio;
+
+import com.sun.jna.Native;
+import com.sun.jna.Pointer;
+import xt.audio.Enums.XtSample;
+import xt.audio.Structs.XtAttributes;
+import xt.audio.Structs.XtBuffer;
+import xt.audio.Structs.XtFormat;
+import java.nio.Buffer;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
+import java.nio.ShortBuffer;
+import java.util.HashMap;
+import java.util.Map;
+
+// Zero-copy alternative to XtSafeBuffer: exposes typed NIO views directly
+// over the native XtBuffer memory. Views are recreated only when the
+// native address or the frame count changes, so steady-state callbacks
+// neither copy nor allocate. Views are only valid inside the callback.
+public final class XtDirectBuffer implements AutoCloseable {
+
+    static final Map<XtStream, XtDirectBuffer> _map = new HashMap<>();
+
+    public static XtDirectBuffer register(XtStream stream, boolean interleaved) {
+        var result = new XtDirectBuffer(stream, interleaved);
+        _map.put(stream, result);
+        return result;
+    }
+
+    private final XtStream _stream;
+    private final XtFormat _format;
+    private final Buffer[] _inputs;
+    private final Buffer[] _outputs;
+    private final XtAttributes _attrs;
+    private final boolean _interleaved;
+    private final long[] _inputAddresses;
+    private final long[] _outputAddresses;
+    private int _inputFrames = -1;
+    private int _outputFrames = -1;
+
+    public void close() { _map.remove(_stream); }
+    public static XtDirectBuffer get(XtStream stream) { return _map.get(stream); }
+    public Object getInput() { return _interleaved? _inputs[0]: _inputs; }
+    public Object getOutput() { return _interleaved? _outputs[0]: _outputs; }
+
+    XtDirectBuffer(XtStream stream, boolean interleaved) {
+        _stream = stream;
+        _interleaved = interleaved;
+        _format = stream.getFormat();
+        _attrs = XtAudio.getSampleAttributes(_format.mix.sample);
+        _inputs = createViews(interleaved? 1: _format.channels.inputs);
+        _outputs = createViews(interleaved? 1: _format.channels.outputs);
+        _inputAddresses = new long[_inputs.length];
+        _outputAddresses = new long[_outputs.length];
+    }
+
+    Buffer[] createViews(int count) {
+        switch(_format.mix.sample) {
+        case UINT8: return new ByteBuffer[count];
+        case INT16: return new ShortBuffer[count];
+        case INT24: return new ByteBuffer[count];
+        case INT32: return new IntBuffer[count];
+        case FLOAT32: return new FloatBuffer[count];
+        default: throw new IllegalArgumentException();
+        }
+    }
+
+    public void update(XtBuffer buffer) {
+        int inputs = _format.channels.inputs;
+        int outputs = _format.channels.outputs;
+        if(buffer.input != Pointer.NULL && inputs > 0)
+            _inputFrames = update(buffer.input, buffer.frames, _inputFrames, inputs, _inputs, _inputAddresses);
+        if(buffer.output != Pointer.NULL && outputs > 0)
+            _outputFrames = update(buffer.output, buffer.frames, _outputFrames, outputs, _outputs, _outputAddresses);
+    }
+
+    int update(Pointer data, int frames, int current, int channels, Buffer[] views, long[] addresses) {
+        int elems = frames * _attrs.count;
+        if(_interleaved) {
+            long address = Pointer.nativeValue(data);
+            if(address != addresses[0] || frames != current) {
+                addresses[0] = address;
+                views[0] = createView(data, channels * elems);
+            }
+            return frames;
+        }
+        for(int i = 0; i < channels; i++) {
+            long address = getChannelAddress(data, i);
+            if(address == addresses[i] && frames == current) continue;
+            addresses[i] = address;
+            views[i] = createView(new Pointer(address), elems);
+        }
+        return frames;
+    }
+
+    long getChannelAddress(Pointer data, int channel) {
+        if(Native.POINTER_SIZE == 8) return data.getLong(channel * 8L);
+        return data.getInt(channel * 4L) & 0xFFFFFFFFL;
+    }
+
+    Buffer createView(Pointer data, int elems) {
+        int bytes = elems * _attrs.size / _attrs.count;
+        ByteBuffer result = data.getByteBuffer(0, bytes).order(ByteOrder.nativeOrder());
+        switch(_format.mix.sample) {
+        case UINT8: return result;
+        case INT16: return result.asShortBuffer();
+        case INT24: return result;
+        case INT32: return result.asIntBuffer();
+        case FLOAT32: return result.asFloatBuffer();
+        default: throw new IllegalArgumentException();
+        }
+    }
+}
\ No newline at end of file
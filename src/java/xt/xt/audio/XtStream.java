@@ -1,52 +1,132 @@
 package xt.audio;
 
+import com.sun.jna.CallbackThreadInitializer;
+import com.sun.jna.Memory;
 import com.sun.jna.Native;
 import com.sun.jna.Pointer;
 import com.sun.jna.ptr.IntByReference;
+import xt.audio.Callbacks.XtOnBudgetExceeded;
+import xt.audio.NativeCallbacks.OnBudgetExceeded;
 import xt.audio.NativeCallbacks.OnBuffer;
+import xt.audio.NativeCallbacks.OnReconfigure;
 import xt.audio.NativeCallbacks.OnRunning;
 import xt.audio.NativeCallbacks.OnXRun;
+import xt.audio.Structs.XtAttributes;
 import xt.audio.Structs.XtBuffer;
 import xt.audio.Structs.XtFormat;
 import xt.audio.Structs.XtLatency;
+import xt.audio.Structs.XtRingStats;
+import xt.audio.Structs.XtRecordingStats;
 import xt.audio.Structs.XtStreamParams;
 import static xt.audio.Utility.handleAssert;
 import static xt.audio.Utility.handleError;
+import java.lang.reflect.Array;
+import java.util.Objects;
 
 public final class XtStream implements AutoCloseable {
 
     static { Native.register(Utility.LIBRARY); }
     private static native void XtStreamStop(Pointer s);
     private static native long XtStreamStart(Pointer s);
+    private static native void XtStreamRewind(Pointer s);
+    private static native long XtStreamSetFreewheel(Pointer s, boolean freewheel);
+    private static native long XtStreamSetBufferSize(Pointer s, double bufferSize);
+    private static native long XtStreamSetPaused(Pointer s, boolean paused);
     private static native void XtStreamDestroy(Pointer s);
     private static native Pointer XtStreamGetHandle(Pointer s);
     private static native boolean XtStreamIsRunning(Pointer s);
     private static native XtFormat XtStreamGetFormat(Pointer s);
     private static native long XtStreamGetLatency(Pointer s, XtLatency latency);
     private static native long XtStreamGetFrames(Pointer s, IntByReference frames);
+    private static native void XtStreamStopRecording(Pointer s);
+    private static native long XtStreamStartRecording(Pointer s, String path, boolean output);
+    private static native void XtStreamGetRecordingStats(Pointer s, XtRecordingStats stats);
+    private static native void XtStreamInitRings(Pointer s, int frames, int prebuffer);
+    private static native int XtStreamRead(Pointer s, Pointer data, int frames, int timeout);
+    private static native int XtStreamWrite(Pointer s, Pointer data, int frames, int timeout);
+    private static native void XtStreamGetRingStats(Pointer s, XtRingStats stats);
+    private static native int XtStreamGetReadyFd(Pointer s, int frames);
+    private static native void XtStreamSetBudget(Pointer s, double fraction, OnBudgetExceeded onBudgetExceeded);
+
+    // XtBuffer is read at fixed offsets rather than through Structure.read,
+    // which goes through reflection. Pointers come first, the remaining
+    // fields are 8-byte aligned on all supported ABIs.
+    private static final long BUFFER_INPUT = 0;
+    private static final long BUFFER_OUTPUT = Native.POINTER_SIZE;
+    private static final long BUFFER_TIME = 2L * Native.POINTER_SIZE;
+    private static final long BUFFER_POSITION = BUFFER_TIME + 8;
+    private static final long BUFFER_FRAMES = BUFFER_POSITION + 8;
+    private static final long BUFFER_TIME_VALID = BUFFER_FRAMES + 4;
+    // Keep native audio threads attached to the JVM between callbacks.
+    private static final CallbackThreadInitializer CALLBACK_THREAD = new CallbackThreadInitializer(true, false, "XT-Audio");
+
+    // Native staging memory for the array overloads of read and write.
+    // One per direction, so a reading and a writing thread never share it.
+    private static final class Staging {
+        Memory data;
+        Memory channels;
+    }
 
     private Pointer _s;
     private XtFormat _format;
+    private XtAttributes _attrs;
 
     private final Object _user;
     private final XtStreamParams _params;
     private final OnXRun _onNativeXRun;
     private final OnBuffer _onNativeBuffer;
     private final OnRunning _onNativeRunning;
+    private final OnReconfigure _onNativeReconfigure;
+    private final OnBudgetExceeded _onNativeBudgetExceeded;
+    private XtOnBudgetExceeded _onBudgetExceeded;
     private final XtBuffer _buffer = new XtBuffer();
     private final XtLatency _latency = new XtLatency();
     private final IntByReference _frames = new IntByReference();
+    private final XtRingStats _ringStats = new XtRingStats();
+    private final XtRecordingStats _recordingStats = new XtRecordingStats();
+    private final Staging _readStaging = new Staging();
+    private final Staging _writeStaging = new Staging();
 
     public XtFormat getFormat() { return _format; }
     public void start() { handleError(XtStreamStart(_s)); }
     public void stop() { handleAssert(() -> XtStreamStop(_s));}
+    public void rewind() { handleAssert(() -> XtStreamRewind(_s)); }
+    public void setFreewheel(boolean freewheel) { handleError(XtStreamSetFreewheel(_s, freewheel)); }
+    public void setBufferSize(double bufferSize) { handleError(XtStreamSetBufferSize(_s, bufferSize)); }
+    public void setPaused(boolean paused) { handleError(XtStreamSetPaused(_s, paused)); }
     public Pointer getHandle() { return handleAssert(XtStreamGetHandle(_s)); }
     public boolean isRunning() { return handleAssert(XtStreamIsRunning(_s)); }
+    public void stopRecording() { handleAssert(() -> XtStreamStopRecording(_s)); }
+    public void startRecording(String path, boolean output) { handleError(XtStreamStartRecording(_s, path, output)); }
+    public void initRings(int frames, int prebuffer) { handleAssert(() -> XtStreamInitRings(_s, frames, prebuffer)); }
+    public int read(Pointer data, int frames, int timeout) { return handleAssert(XtStreamRead(_s, data, frames, timeout)); }
+    public int write(Pointer data, int frames, int timeout) { return handleAssert(XtStreamWrite(_s, data, frames, timeout)); }
+    public int getReadyFd(int frames) { return handleAssert(XtStreamGetReadyFd(_s, frames)); }
+
+    // Interleaved streams take a single array holding all channels,
+    // non-interleaved streams one array per channel.
+    public int read(byte[] data, int frames, int timeout) { return readArray(data, frames, timeout); }
+    public int read(short[] data, int frames, int timeout) { return readArray(data, frames, timeout); }
+    public int read(int[] data, int frames, int timeout) { return readArray(data, frames, timeout); }
+    public int read(float[] data, int frames, int timeout) { return readArray(data, frames, timeout); }
+    public int read(byte[][] data, int frames, int timeout) { return readArray(data, frames, timeout); }
+    public int read(short[][] data, int frames, int timeout) { return readArray(data, frames, timeout); }
+    public int read(int[][] data, int frames, int timeout) { return readArray(data, frames, timeout); }
+    public int read(float[][] data, int frames, int timeout) { return readArray(data, frames, timeout); }
+    public int write(byte[] data, int frames, int timeout) { return writeArray(data, frames, timeout); }
+    public int write(short[] data, int frames, int timeout) { return writeArray(data, frames, timeout); }
+    public int write(int[] data, int frames, int timeout) { return writeArray(data, frames, timeout); }
+    public int write(float[] data, int frames, int timeout) { return writeArray(data, frames, timeout); }
+    public int write(byte[][] data, int frames, int timeout) { return writeArray(data, frames, timeout); }
+    public int write(short[][] data, int frames, int timeout) { return writeArray(data, frames, timeout); }
+    public int write(int[][] data, int frames, int timeout) { return writeArray(data, frames, timeout); }
+    public int write(float[][] data, int frames, int timeout) { return writeArray(data, frames, timeout); }
     @Override public void close() { handleAssert(() -> XtStreamDestroy(_s)); _s = Pointer.NULL; }
 
     OnXRun onNativeXRun() { return _onNativeXRun; }
     OnBuffer onNativeBuffer() { return _onNativeBuffer; }
     OnRunning onNativeRunning() { return _onNativeRunning; }
+    OnReconfigure onNativeReconfigure() { return _onNativeReconfigure; }
 
     XtStream(XtStreamParams params, Object user) {
         _user = user;
@@ -54,11 +134,19 @@ public final class XtStream implements AutoCloseable {
         _onNativeXRun = this::onXRun;
         _onNativeBuffer = this::onBuffer;
         _onNativeRunning = this::onRunning;
+        _onNativeReconfigure = this::onReconfigure;
+        _onNativeBudgetExceeded = this::onBudgetExceeded;
+        Native.setCallbackThreadInitializer(_onNativeXRun, CALLBACK_THREAD);
+        Native.setCallbackThreadInitializer(_onNativeBuffer, CALLBACK_THREAD);
+        Native.setCallbackThreadInitializer(_onNativeRunning, CALLBACK_THREAD);
+        Native.setCallbackThreadInitializer(_onNativeReconfigure, CALLBACK_THREAD);
+        Native.setCallbackThreadInitializer(_onNativeBudgetExceeded, CALLBACK_THREAD);
     }
 
     void init(Pointer s) {
         _s = s;
         _format = handleAssert(XtStreamGetFormat(_s));
+        _attrs = XtAudio.getSampleAttributes(_format.mix.sample);
     }
 
     public int getFrames() {
@@ -71,18 +159,109 @@ public final class XtStream implements AutoCloseable {
         return _latency;
     }
 
+    public void setBudget(double fraction, XtOnBudgetExceeded onBudgetExceeded) {
+        var forward = onBudgetExceeded == null? null: _onNativeBudgetExceeded;
+        if(onBudgetExceeded != null) _onBudgetExceeded = onBudgetExceeded;
+        handleAssert(() -> XtStreamSetBudget(_s, fraction, forward));
+        _onBudgetExceeded = onBudgetExceeded;
+    }
+
+    public XtRingStats getRingStats() {
+        handleAssert(() -> XtStreamGetRingStats(_s, _ringStats));
+        return _ringStats;
+    }
+
+    public XtRecordingStats getRecordingStats() {
+        handleAssert(() -> XtStreamGetRecordingStats(_s, _recordingStats));
+        return _recordingStats;
+    }
+
+    private int readArray(Object data, int frames, int timeout) {
+        int channels = _format.channels.inputs;
+        Pointer buffer = stage(_readStaging, data, frames, channels);
+        int read = handleAssert(XtStreamRead(_s, buffer, frames, timeout));
+        copy(_readStaging, data, read, frames, channels, false);
+        return read;
+    }
+
+    private int writeArray(Object data, int frames, int timeout) {
+        int channels = _format.channels.outputs;
+        Pointer buffer = stage(_writeStaging, data, frames, channels);
+        copy(_writeStaging, data, frames, frames, channels, true);
+        return handleAssert(XtStreamWrite(_s, buffer, frames, timeout));
+    }
+
+    // Validates the array against the stream format and returns the native
+    // buffer to pass on: the data itself or, non-interleaved, the channel
+    // pointers. Channel i starts at i * frames samples into the data.
+    private Pointer stage(Staging staging, Object data, int frames, int channels) {
+        Objects.requireNonNull(data, "data");
+        if(frames < 0) throw new IllegalArgumentException("frames");
+        if(channels == 0) throw new IllegalStateException("Stream has no channels in this direction.");
+        boolean interleaved = !data.getClass().getComponentType().isArray();
+        if(interleaved != _params.interleaved)
+            throw new IllegalArgumentException(_params.interleaved? "Stream is interleaved.": "Stream is non-interleaved.");
+        var expected = XtSafeBuffer._types.get(_format.mix.sample);
+        var type = interleaved? data.getClass().getComponentType(): data.getClass().getComponentType().getComponentType();
+        if(type != expected) throw new IllegalArgumentException("Expected " + expected + " samples.");
+        long elems = (long)frames * _attrs.count;
+        if(interleaved && Array.getLength(data) < elems * channels) throw new IllegalArgumentException("Buffer too small.");
+        if(!interleaved && Array.getLength(data) != channels) throw new IllegalArgumentException("Expected " + channels + " channels.");
+        for(int i = 0; !interleaved && i < channels; i++)
+            if(Array.get(data, i) == null || Array.getLength(Array.get(data, i)) < elems) throw new IllegalArgumentException("Buffer too small.");
+        long bytes = Math.max(1L, (long)frames * channels * _attrs.size);
+        if(staging.data == null || staging.data.size() < bytes) staging.data = new Memory(bytes);
+        if(interleaved) return staging.data;
+        long pointers = (long)channels * Native.POINTER_SIZE;
+        if(staging.channels == null || staging.channels.size() < pointers) staging.channels = new Memory(pointers);
+        for(int i = 0; i < channels; i++)
+            staging.channels.setPointer((long)i * Native.POINTER_SIZE, staging.data.share((long)i * frames * _attrs.size));
+        return staging.channels;
+    }
+
+    private void copy(Staging staging, Object data, int frames, int stride, int channels, boolean toNative) {
+        int elems = frames * _attrs.count;
+        if(_params.interleaved) transfer(staging.data, 0, data, elems * channels, toNative);
+        else for(int i = 0; i < channels; i++)
+            transfer(staging.data, (long)i * stride * _attrs.size, Array.get(data, i), elems, toNative);
+    }
+
+    private static void transfer(Pointer buffer, long offset, Object data, int count, boolean toNative) {
+        if(data instanceof byte[] && toNative) buffer.write(offset, (byte[])data, 0, count);
+        else if(data instanceof byte[]) buffer.read(offset, (byte[])data, 0, count);
+        else if(data instanceof short[] && toNative) buffer.write(offset, (short[])data, 0, count);
+        else if(data instanceof short[]) buffer.read(offset, (short[])data, 0, count);
+        else if(data instanceof int[] && toNative) buffer.write(offset, (int[])data, 0, count);
+        else if(data instanceof int[]) buffer.read(offset, (int[])data, 0, count);
+        else if(data instanceof float[] && toNative) buffer.write(offset, (float[])data, 0, count);
+        else if(data instanceof float[]) buffer.read(offset, (float[])data, 0, count);
+        else throw new IllegalArgumentException();
+    }
+
     private void onXRun(Pointer stream, int index, Pointer user) throws Exception {
         _params.onXRun.callback(this, index, _user);
     }
 
     private int onBuffer(Pointer stream, Pointer buffer, Pointer user) throws Exception {
-        for(int i = 0; i < Native.getNativeSize(XtBuffer.ByValue.class); i++)
-            _buffer.getPointer().setByte(i, buffer.getByte(i));
-        _buffer.read();
+        _buffer.input = buffer.getPointer(BUFFER_INPUT);
+        _buffer.output = buffer.getPointer(BUFFER_OUTPUT);
+        _buffer.time = buffer.getDouble(BUFFER_TIME);
+        _buffer.position = buffer.getLong(BUFFER_POSITION);
+        _buffer.frames = buffer.getInt(BUFFER_FRAMES);
+        _buffer.timeValid = buffer.getInt(BUFFER_TIME_VALID) != 0;
         return _params.onBuffer.callback(this, _buffer, _user);
     }
 
     private void onRunning(Pointer stream, boolean running, long error, Object user) throws Exception {
         _params.onRunning.callback(this, running, error, user);
     }
+
+    private void onBudgetExceeded(Pointer stream, double duration, double budget, Pointer user) throws Exception {
+        _onBudgetExceeded.callback(this, duration, budget, _user);
+    }
+
+    private void onReconfigure(Pointer stream, int frames, int rate, Pointer user) throws Exception {
+        _format.read();
+        _params.onReconfigure.callback(this, frames, rate, _user);
+    }
 }
\ No newline at end of file
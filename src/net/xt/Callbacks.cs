@@ -11,8 +11,14 @@ namespace Xt
     delegate int OnBuffer(IntPtr stream, in XtBuffer buffer, IntPtr user);
     [SuppressUnmanagedCodeSecurity]
     delegate void OnRunning(IntPtr stream, int running, ulong error, IntPtr user);
+    [SuppressUnmanagedCodeSecurity]
+    delegate void OnReconfigure(IntPtr stream, int frames, int rate, IntPtr user);
+    [SuppressUnmanagedCodeSecurity]
+    delegate void OnBudgetExceeded(IntPtr stream, double duration, double budget, IntPtr user);
 
     public delegate void XtOnXRun(XtStream stream, int index, object user);
     public delegate int XtOnBuffer(XtStream stream, in XtBuffer buffer, object user);
     public delegate void XtOnRunning(XtStream stream, bool running, ulong error, object user);
+    public delegate void XtOnReconfigure(XtStream stream, int frames, int rate, object user);
+    public delegate void XtOnBudgetExceeded(XtStream stream, double duration, double budget, object user);
 }
\ No newline at end of file
@@ -24,9 +24,10 @@ namespace Xt
     struct StreamParams
     {
         public int interleaved;
-        public OnBuffer onBuffer;
-        public OnXRun onXRun;
-        public OnRunning onRunning;
+        public IntPtr onBuffer;
+        public IntPtr onXRun;
+        public IntPtr onRunning;
+        public IntPtr onReconfigure;
     }
 
     [StructLayout(LayoutKind.Sequential)]
@@ -53,6 +54,23 @@ namespace Xt
         public double output;
     }
 
+    [StructLayout(LayoutKind.Sequential)]
+    public struct XtRingStats
+    {
+        public int readable;
+        public int writable;
+        public ulong overflows;
+        public ulong underflows;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct XtRecordingStats
+    {
+        public ulong written;
+        public ulong lag;
+        public ulong dropped;
+    }
+
     [StructLayout(LayoutKind.Sequential)]
     public struct XtBufferSize
     {
@@ -71,6 +89,18 @@ namespace Xt
         public int frames;
         int _timeValid;
         public bool timeValid => _timeValid != 0;
+#if NET5_0_OR_GREATER
+        public readonly unsafe ReadOnlySpan<T> GetInput<T>(in XtFormat format) where T : unmanaged
+        => new ReadOnlySpan<T>((void*)input, GetElements<T>(format.mix.sample, format.channels.inputs));
+        public readonly unsafe ReadOnlySpan<T> GetInput<T>(in XtFormat format, int channel) where T : unmanaged
+        => new ReadOnlySpan<T>(((void**)input)[channel], GetElements<T>(format.mix.sample, 1));
+        public readonly unsafe Span<T> GetOutput<T>(in XtFormat format) where T : unmanaged
+        => new Span<T>((void*)output, GetElements<T>(format.mix.sample, format.channels.outputs));
+        public readonly unsafe Span<T> GetOutput<T>(in XtFormat format, int channel) where T : unmanaged
+        => new Span<T>(((void**)output)[channel], GetElements<T>(format.mix.sample, 1));
+        readonly unsafe int GetElements<T>(XtSample sample, int channels) where T : unmanaged
+        => frames * channels * (sample == XtSample.UInt8 ? 1 : sample == XtSample.Int16 ? 2 : sample == XtSample.Int24 ? 3 : 4) / sizeof(T);
+#endif
     }
 
     [StructLayout(LayoutKind.Sequential)]
@@ -154,8 +184,11 @@ namespace Xt
         public XtOnBuffer onBuffer;
         public XtOnXRun onXRun;
         public XtOnRunning onRunning;
+        public XtOnReconfigure onReconfigure;
         public XtStreamParams(bool interleaved, XtOnBuffer onBuffer, XtOnXRun onXRun, XtOnRunning onRunning)
-        => (this.interleaved, this.onBuffer, this.onXRun, this.onRunning) = (interleaved, onBuffer, onXRun, onRunning);
+        => (this.interleaved, this.onBuffer, this.onXRun, this.onRunning, this.onReconfigure) = (interleaved, onBuffer, onXRun, onRunning, null);
+        public XtStreamParams(bool interleaved, XtOnBuffer onBuffer, XtOnXRun onXRun, XtOnRunning onRunning, XtOnReconfigure onReconfigure)
+        => (this.interleaved, this.onBuffer, this.onXRun, this.onRunning, this.onReconfigure) = (interleaved, onBuffer, onXRun, onRunning, onReconfigure);
     }
 
     public struct XtAggregateStreamParams
@@ -30,6 +30,10 @@ namespace Xt
         static extern void XtAudioSetAssertTerminates(int terminates);
         [DllImport("xt-audio")]
         static extern XtAttributes XtAudioGetSampleAttributes(XtSample sample);
+        [DllImport("xt-audio")]
+        static extern int XtAudioWriteTrace(byte[] path);
+        [DllImport("xt-audio")]
+        static extern ulong XtAudioGetRtViolations();
 
         static XtOnError _onError;
 
@@ -54,6 +58,11 @@ namespace Xt
         public static XtAttributes GetSampleAttributes(XtSample sample)
         => HandleAssert(XtAudioGetSampleAttributes(sample));
 
+        public static ulong GetRtViolations()
+        => HandleAssert(XtAudioGetRtViolations());
+        public static bool WriteTrace(string path)
+        => HandleAssert(XtAudioWriteTrace(Encoding.UTF8.GetBytes(path + char.MinValue)) != 0);
+
         public static void SetOnError(XtOnError onError)
         {
             _onError = onError;
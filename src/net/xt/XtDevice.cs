@@ -70,11 +70,12 @@ namespace Xt
             var native = new DeviceStreamParams();
             native.format = @params.format;
             native.bufferSize = @params.bufferSize;
-            native.stream.onBuffer = result.OnNativeBuffer();
+            native.stream.onBuffer = @params.stream.onBuffer == null ? IntPtr.Zero : result.OnNativeBuffer();
             native.stream.interleaved = @params.stream.interleaved ? 1 : 0;
-            native.stream.onXRun = @params.stream.onXRun == null ? null : result.OnNativeXRun();
-            native.stream.onRunning = @params.stream.onRunning == null ? null : result.OnNativeRunning();
-            result.Init(HandleError(XtDeviceOpenStream(_d, @native, IntPtr.Zero, out var r), r));
+            native.stream.onXRun = @params.stream.onXRun == null ? IntPtr.Zero : result.OnNativeXRun();
+            native.stream.onRunning = @params.stream.onRunning == null ? IntPtr.Zero : result.OnNativeRunning();
+            native.stream.onReconfigure = @params.stream.onReconfigure == null ? IntPtr.Zero : result.OnNativeReconfigure();
+            result.Init(() => HandleError(XtDeviceOpenStream(_d, @native, result.NativeUser(), out var r), r));
             return result;
         }
     }
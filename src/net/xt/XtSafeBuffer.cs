@@ -9,7 +9,7 @@ namespace Xt
         static readonly Dictionary<XtStream, XtSafeBuffer> _map 
         = new Dictionary<XtStream, XtSafeBuffer>();
 
-        static readonly Dictionary<XtSample, Type> _types 
+        internal static readonly Dictionary<XtSample, Type> _types 
         = new Dictionary<XtSample, Type>()
         {
             { XtSample.UInt8, typeof(byte) },
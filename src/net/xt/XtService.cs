@@ -67,11 +67,12 @@ namespace Xt
                 native.count = @params.count;
                 native.devices = new IntPtr(devs);
                 native.master = @params.master.Handle();
-                native.stream.onBuffer = result.OnNativeBuffer();
+                native.stream.onBuffer = @params.stream.onBuffer == null ? IntPtr.Zero : result.OnNativeBuffer();
                 native.stream.interleaved = @params.stream.interleaved ? 1 : 0;
-                native.stream.onXRun = @params.stream.onXRun == null ? null : result.OnNativeXRun();
-                native.stream.onRunning = @params.stream.onRunning == null ? null : result.OnNativeRunning();
-                result.Init(HandleError(XtServiceAggregateStream(_s, in native, IntPtr.Zero, out var r), r));
+                native.stream.onXRun = @params.stream.onXRun == null ? IntPtr.Zero : result.OnNativeXRun();
+                native.stream.onRunning = @params.stream.onRunning == null ? IntPtr.Zero : result.OnNativeRunning();
+                native.stream.onReconfigure = @params.stream.onReconfigure == null ? IntPtr.Zero : result.OnNativeReconfigure();
+                result.Init(() => HandleError(XtServiceAggregateStream(_s, in native, result.NativeUser(), out var r), r));
                 return result;
             }
         }
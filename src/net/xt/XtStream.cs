@@ -1,6 +1,8 @@
 using System;
+using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
 using System.Security;
+using System.Text;
 using static Xt.Utility;
 
 namespace Xt
@@ -13,6 +15,14 @@ namespace Xt
         [DllImport("xt-audio")] 
         static extern ulong XtStreamStart(IntPtr s);
         [DllImport("xt-audio")] 
+        static extern void XtStreamRewind(IntPtr s);
+        [DllImport("xt-audio")] 
+        static extern ulong XtStreamSetFreewheel(IntPtr s, bool freewheel);
+        [DllImport("xt-audio")]
+        static extern ulong XtStreamSetBufferSize(IntPtr s, double bufferSize);
+        [DllImport("xt-audio")]
+        static extern ulong XtStreamSetPaused(IntPtr s, bool paused);
+        [DllImport("xt-audio")] 
         static extern void XtStreamDestroy(IntPtr s);
         [DllImport("xt-audio")] 
         static extern int XtStreamIsRunning(IntPtr s);
@@ -24,13 +34,78 @@ namespace Xt
         static extern ulong XtStreamGetFrames(IntPtr s, out int frames);
         [DllImport("xt-audio")]
         static extern ulong XtStreamGetLatency(IntPtr s, out XtLatency latency);
+        [DllImport("xt-audio")]
+        static extern void XtStreamStopRecording(IntPtr s);
+        [DllImport("xt-audio")]
+        static extern ulong XtStreamStartRecording(IntPtr s, byte[] path, bool output);
+        [DllImport("xt-audio")]
+        static extern void XtStreamGetRecordingStats(IntPtr s, out XtRecordingStats stats);
+        [DllImport("xt-audio")]
+        static extern void XtStreamInitRings(IntPtr s, int frames, int prebuffer);
+        [DllImport("xt-audio")]
+        static extern int XtStreamRead(IntPtr s, IntPtr data, int frames, int timeout);
+        [DllImport("xt-audio")]
+        static extern int XtStreamWrite(IntPtr s, IntPtr data, int frames, int timeout);
+        [DllImport("xt-audio")]
+        static extern void XtStreamGetRingStats(IntPtr s, out XtRingStats stats);
+        [DllImport("xt-audio")]
+        static extern int XtStreamGetReadyFd(IntPtr s, int frames);
+        [DllImport("xt-audio")]
+        static extern void XtStreamSetBudget(IntPtr s, double fraction, IntPtr onBudgetExceeded);
 
         IntPtr _s;
+        GCHandle _handle;
         readonly object _user;
         readonly XtStreamParams _params;
+        XtOnBudgetExceeded _onBudgetExceeded;
+
+        internal IntPtr NativeUser() => GCHandle.ToIntPtr(_handle);
+        static XtStream FromNativeUser(IntPtr user) => (XtStream)GCHandle.FromIntPtr(user).Target;
+
+        internal void Init(Func<IntPtr> open)
+        {
+            try { _s = open(); }
+            catch { _handle.Free(); throw; }
+        }
+
+#if NET5_0_OR_GREATER
+        // Static entry points reached through unmanaged function pointers, 
+        // the stream is recovered from the native user data. No delegates
+        // or marshaling thunks are involved on the audio thread.
+        internal XtStream(in XtStreamParams @params, object user)
+        {
+            _user = user;
+            _params = @params;
+            _handle = GCHandle.Alloc(this, GCHandleType.Weak);
+        }
+
+        internal unsafe IntPtr OnNativeXRun() => (IntPtr)(delegate* unmanaged[Stdcall]<IntPtr, int, IntPtr, void>)&OnXRun;
+        internal unsafe IntPtr OnNativeBuffer() => (IntPtr)(delegate* unmanaged[Stdcall]<IntPtr, XtBuffer*, IntPtr, int>)&OnBuffer;
+        internal unsafe IntPtr OnNativeRunning() => (IntPtr)(delegate* unmanaged[Stdcall]<IntPtr, int, ulong, IntPtr, void>)&OnRunning;
+        internal unsafe IntPtr OnNativeReconfigure() => (IntPtr)(delegate* unmanaged[Stdcall]<IntPtr, int, int, IntPtr, void>)&OnReconfigure;
+        internal unsafe IntPtr OnNativeBudgetExceeded() => (IntPtr)(delegate* unmanaged[Stdcall]<IntPtr, double, double, IntPtr, void>)&OnBudgetExceeded;
+
+        [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvStdcall) })]
+        static void OnXRun(IntPtr stream, int index, IntPtr user)
+        { var s = FromNativeUser(user); s._params.onXRun(s, index, s._user); }
+        [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvStdcall) })]
+        static unsafe int OnBuffer(IntPtr stream, XtBuffer* buffer, IntPtr user)
+        { var s = FromNativeUser(user); return s._params.onBuffer(s, in *buffer, s._user); }
+        [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvStdcall) })]
+        static void OnRunning(IntPtr stream, int running, ulong error, IntPtr user)
+        { var s = FromNativeUser(user); s._params.onRunning(s, running != 0, error, s._user); }
+        [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvStdcall) })]
+        static void OnReconfigure(IntPtr stream, int frames, int rate, IntPtr user)
+        { var s = FromNativeUser(user); s._params.onReconfigure(s, frames, rate, s._user); }
+        [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvStdcall) })]
+        static void OnBudgetExceeded(IntPtr stream, double duration, double budget, IntPtr user)
+        { var s = FromNativeUser(user); s._onBudgetExceeded(s, duration, budget, s._user); }
+#else
         readonly OnXRun _onNativeXRun;
         readonly OnBuffer _onNativeBuffer;
         readonly OnRunning _onNativeRunning;
+        readonly OnReconfigure _onNativeReconfigure;
+        readonly OnBudgetExceeded _onNativeBudgetExceeded;
 
         internal XtStream(in XtStreamParams @params, object user)
         {
@@ -39,12 +114,16 @@ namespace Xt
             _onNativeXRun = OnXRun;
             _onNativeBuffer = OnBuffer;
             _onNativeRunning = OnRunning;
+            _onNativeReconfigure = OnReconfigure;
+            _onNativeBudgetExceeded = OnBudgetExceeded;
+            _handle = GCHandle.Alloc(this, GCHandleType.Weak);
         }
 
-        internal void Init(IntPtr s) => _s = s;
-        internal OnXRun OnNativeXRun() => _onNativeXRun;
-        internal OnBuffer OnNativeBuffer() => _onNativeBuffer;
-        internal OnRunning OnNativeRunning() => _onNativeRunning;
+        internal IntPtr OnNativeXRun() => Marshal.GetFunctionPointerForDelegate(_onNativeXRun);
+        internal IntPtr OnNativeBuffer() => Marshal.GetFunctionPointerForDelegate(_onNativeBuffer);
+        internal IntPtr OnNativeRunning() => Marshal.GetFunctionPointerForDelegate(_onNativeRunning);
+        internal IntPtr OnNativeReconfigure() => Marshal.GetFunctionPointerForDelegate(_onNativeReconfigure);
+        internal IntPtr OnNativeBudgetExceeded() => Marshal.GetFunctionPointerForDelegate(_onNativeBudgetExceeded);
 
         void OnXRun(IntPtr stream, int index, IntPtr user) 
         => _params.onXRun(this, index, _user);
@@ -52,14 +131,130 @@ namespace Xt
         => _params.onBuffer(this, in buffer, _user);
         void OnRunning(IntPtr stream, int running, ulong error, IntPtr user)
         => _params.onRunning(this, running != 0, error, _user);
+        void OnReconfigure(IntPtr stream, int frames, int rate, IntPtr user)
+        => _params.onReconfigure(this, frames, rate, _user);
+        void OnBudgetExceeded(IntPtr stream, double duration, double budget, IntPtr user)
+        => _onBudgetExceeded(this, duration, budget, _user);
+#endif
 
         public void Start() => HandleError(XtStreamStart(_s));
         public void Stop() => HandleAssert(() => XtStreamStop(_s));
+        public void Rewind() => HandleAssert(() => XtStreamRewind(_s));
+        public void SetFreewheel(bool freewheel) => HandleError(XtStreamSetFreewheel(_s, freewheel));
+        public void SetBufferSize(double bufferSize) => HandleError(XtStreamSetBufferSize(_s, bufferSize));
+        public void SetPaused(bool paused) => HandleError(XtStreamSetPaused(_s, paused));
         public IntPtr GetHandle() => HandleAssert(XtStreamGetHandle(_s));
         public bool IsRunning() => HandleAssert(XtStreamIsRunning(_s) != 0);
         public unsafe XtFormat GetFormat() => HandleAssert(*XtStreamGetFormat(_s));
         public int GetFrames() => HandleError(XtStreamGetFrames(_s, out var r), r);
         public XtLatency GetLatency() => HandleError(XtStreamGetLatency(_s, out var r), r);
-        public void Dispose() { HandleAssert(() => XtStreamDestroy(_s)); _s = IntPtr.Zero; }
+        public void StopRecording() => HandleAssert(() => XtStreamStopRecording(_s));
+        public void StartRecording(string path, bool output) => HandleError(XtStreamStartRecording(_s, Encoding.UTF8.GetBytes(path + char.MinValue), output));
+        public void InitRings(int frames, int prebuffer) => HandleAssert(() => XtStreamInitRings(_s, frames, prebuffer));
+        public int Read(IntPtr data, int frames, int timeout) => HandleAssert(XtStreamRead(_s, data, frames, timeout));
+        public int Write(IntPtr data, int frames, int timeout) => HandleAssert(XtStreamWrite(_s, data, frames, timeout));
+        public int GetReadyFd(int frames) => HandleAssert(XtStreamGetReadyFd(_s, frames));
+
+        // Typed overloads pin the managed buffers for the duration of the call,
+        // nothing is copied. Interleaved streams take a single array holding
+        // all channels, non-interleaved streams one array per channel.
+        public unsafe int Read<T>(T[] data, int frames, int timeout) where T : unmanaged
+        {
+            CheckInterleaved<T>(data?.Length ?? -1, frames, GetFormat().channels.inputs);
+            fixed (T* p = data) return Read(new IntPtr(p), frames, timeout);
+        }
+
+        public unsafe int Write<T>(T[] data, int frames, int timeout) where T : unmanaged
+        {
+            CheckInterleaved<T>(data?.Length ?? -1, frames, GetFormat().channels.outputs);
+            fixed (T* p = data) return Write(new IntPtr(p), frames, timeout);
+        }
+
+        public int Read<T>(T[][] data, int frames, int timeout) where T : unmanaged
+        => TransferChannels(data, frames, GetFormat().channels.inputs, p => Read(p, frames, timeout));
+        public int Write<T>(T[][] data, int frames, int timeout) where T : unmanaged
+        => TransferChannels(data, frames, GetFormat().channels.outputs, p => Write(p, frames, timeout));
+
+#if NET5_0_OR_GREATER
+        public unsafe int Read<T>(Span<T> data, int frames, int timeout) where T : unmanaged
+        {
+            CheckInterleaved<T>(data.Length, frames, GetFormat().channels.inputs);
+            fixed (T* p = data) return Read(new IntPtr(p), frames, timeout);
+        }
+
+        public unsafe int Write<T>(ReadOnlySpan<T> data, int frames, int timeout) where T : unmanaged
+        {
+            CheckInterleaved<T>(data.Length, frames, GetFormat().channels.outputs);
+            fixed (T* p = data) return Write(new IntPtr(p), frames, timeout);
+        }
+#endif
+
+        void CheckType<T>(int frames, int channels)
+        {
+            var sample = GetFormat().mix.sample;
+            if (frames < 0) throw new ArgumentOutOfRangeException(nameof(frames));
+            if (channels == 0) throw new InvalidOperationException("Stream has no channels in this direction.");
+            if (XtSafeBuffer._types[sample] != typeof(T)) throw new ArgumentException($"Expected {XtSafeBuffer._types[sample]} samples.", "data");
+        }
+
+        void CheckInterleaved<T>(int length, int frames, int channels)
+        {
+            CheckType<T>(frames, channels);
+            if (length < 0) throw new ArgumentNullException("data");
+            if (!_params.interleaved) throw new ArgumentException("Stream is non-interleaved.", "data");
+            int count = XtAudio.GetSampleAttributes(GetFormat().mix.sample).count;
+            if (length < (long)frames * channels * count) throw new ArgumentException("Buffer too small.", "data");
+        }
+
+        unsafe int TransferChannels<T>(T[][] data, int frames, int channels, Func<IntPtr, int> transfer) where T : unmanaged
+        {
+            CheckType<T>(frames, channels);
+            if (data == null) throw new ArgumentNullException(nameof(data));
+            if (_params.interleaved) throw new ArgumentException("Stream is interleaved.", nameof(data));
+            if (data.Length != channels) throw new ArgumentException($"Expected {channels} channels.", nameof(data));
+            int count = XtAudio.GetSampleAttributes(GetFormat().mix.sample).count;
+            foreach (var channel in data)
+                if (channel == null || channel.Length < (long)frames * count) throw new ArgumentException("Buffer too small.", nameof(data));
+            var handles = new GCHandle[channels];
+            IntPtr* pointers = stackalloc IntPtr[channels];
+            try
+            {
+                for (int i = 0; i < channels; i++) handles[i] = GCHandle.Alloc(data[i], GCHandleType.Pinned);
+                for (int i = 0; i < channels; i++) pointers[i] = handles[i].AddrOfPinnedObject();
+                return transfer(new IntPtr(pointers));
+            }
+            finally
+            {
+                foreach (var handle in handles) if (handle.IsAllocated) handle.Free();
+            }
+        }
+
+        public void SetBudget(double fraction, XtOnBudgetExceeded onBudgetExceeded)
+        {
+            var forward = onBudgetExceeded == null ? IntPtr.Zero : OnNativeBudgetExceeded();
+            if (onBudgetExceeded != null) _onBudgetExceeded = onBudgetExceeded;
+            HandleAssert(() => XtStreamSetBudget(_s, fraction, forward));
+            _onBudgetExceeded = onBudgetExceeded;
+        }
+
+        public XtRingStats GetRingStats()
+        {
+            var stats = new XtRingStats();
+            HandleAssert(() => XtStreamGetRingStats(_s, out stats));
+            return stats;
+        }
+
+        public XtRecordingStats GetRecordingStats()
+        {
+            var stats = new XtRecordingStats();
+            HandleAssert(() => XtStreamGetRecordingStats(_s, out stats));
+            return stats;
+        }
+        public void Dispose()
+        {
+            HandleAssert(() => XtStreamDestroy(_s));
+            _s = IntPtr.Zero;
+            if (_handle.IsAllocated) _handle.Free();
+        }
     }
 }
\ No newline at end of file